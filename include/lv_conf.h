@@ -372,8 +372,11 @@
  *  - 254: round up */
 #define LV_COLOR_MIX_ROUND_OFS  0
 
-/** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
-#define LV_OBJ_STYLE_CACHE      0
+/** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties.
+ *  Build with -D LV_OBJ_STYLE_CACHE=0 to compare against no cache (see DEBUG_UI_STYLES). */
+#ifndef LV_OBJ_STYLE_CACHE
+    #define LV_OBJ_STYLE_CACHE  1
+#endif
 
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
@@ -832,7 +835,7 @@
 /* Documentation for several of the below items can be found here: https://docs.lvgl.io/master/details/auxiliary-modules/index.html . */
 
 /** 1: Enable API to take snapshot for object */
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /** 1: Enable system monitor component */
 #define LV_USE_SYSMON   1
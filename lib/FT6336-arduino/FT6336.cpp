@@ -7,63 +7,125 @@ FT6336::FT6336(uint8_t _sda, uint8_t _scl, uint8_t _int, uint8_t _rst, uint16_t
 
 }
 
+void FT6336::setTransport(FT6336ReadFn readFn, FT6336WriteFn writeFn, void *ctx) {
+  transportRead = readFn;
+  transportWrite = writeFn;
+  transportCtx = ctx;
+}
+
+void FT6336::onInterrupt(void (*callback)(void *), void *ctx) {
+  interruptCallback = callback;
+  interruptCtx = ctx;
+}
+
 void FT6336::begin(uint8_t _addr) {
   addr = _addr;
-  Wire.begin(pinSda, pinScl);
-  if(reset())
-  {
-    Serial.print("touch ic error!\r\n");
+  if (transportRead == nullptr) {
+    Wire.begin(pinSda, pinScl);
   }
+  reset();
 }
 
-uint8_t FT6336::reset() {
-  uint8_t tmp[2];
-  pinMode(pinInt, INPUT);
+void FT6336::reset() {
+  detachInterrupt(digitalPinToInterrupt(pinInt));
+  pinMode(pinInt, INPUT_PULLUP);
   pinMode(pinRst, OUTPUT);
-  digitalWrite(pinInt, 1);
-  digitalWrite(pinRst, 1);
-  delay(20);
   digitalWrite(pinRst, 0);
-  delay(20);
-  digitalWrite(pinRst, 1);
-  delay(500);
-  readBlockData(&tmp[0], FT6336_ID_G_FOCALTECH_ID, 1);
-  if(tmp[0] != 0x11)
-  {
-    return 1;
-  }
-  readBlockData(tmp, FT6336_ID_G_CIPHER_MID, 2);
-  if(tmp[0] != 0x26)
-  {
-    return 1;
-  }
-  if((tmp[1]!=0x00)&&(tmp[1]!=0x01)&&(tmp[1]!=0x02))
-  {
-    return 1;
-  }
-  readBlockData(&tmp[0], FT6336_ID_G_CIPHER_HIGH, 1);
-  if(tmp[0] != 0x64)
-  {
-    return 1;
-  }
-  return 0;
+  resetStarted = millis();
+  resetState = RESET_LOW;
+}
+
+bool FT6336::update() {
+  switch (resetState) {
+    case RESET_LOW:
+      if (millis() - resetStarted >= FT6336_RESET_LOW_MS) {
+        digitalWrite(pinRst, 1);
+        resetStarted = millis();
+        resetState = STARTING_UP;
+      }
+      break;
+    case STARTING_UP:
+      if (millis() - resetStarted >= FT6336_RESET_STARTUP_MS) {
+        if (!identify()) {
+          stats.errors++;
+          resetState = FAILED;
+          Serial.print("touch ic error!\r\n");
+          break;
+        }
+        // One INT pulse per new report instead of holding the line while touched
+        writeByteData(FT6336_ID_G_MODE, 1);
+        attachInterruptArg(digitalPinToInterrupt(pinInt), onInterruptStatic, this, FALLING);
+        resetState = READY;
+      }
+      break;
+    default:
+      break;
+  }
+  return resetState == READY;
+}
+
+bool FT6336::identify() {
+  uint8_t tmp[2];
+  if (!readBlockData(&tmp[0], FT6336_ID_G_FOCALTECH_ID, 1) || tmp[0] != 0x11) {
+    return false;
+  }
+  if (!readBlockData(tmp, FT6336_ID_G_CIPHER_MID, 2) || tmp[0] != 0x26) {
+    return false;
+  }
+  if ((tmp[1]!=0x00)&&(tmp[1]!=0x01)&&(tmp[1]!=0x02)) {
+    return false;
+  }
+  if (!readBlockData(&tmp[0], FT6336_ID_G_CIPHER_HIGH, 1) || tmp[0] != 0x64) {
+    return false;
+  }
+  return true;
+}
+
+void ARDUINO_ISR_ATTR FT6336::onInterruptStatic(void *arg) {
+  FT6336 *self = (FT6336 *)arg;
+  self->interruptMicros = micros();
+  self->interruptPending = true;
+  self->stats.interrupts++;
+  if (self->interruptCallback) {
+    self->interruptCallback(self->interruptCtx);
+  }
 }
 
 void FT6336::setRotation(uint8_t rot) {
   rotation = rot;
 }
 
-void FT6336::read(void) {
-  uint8_t data[4];
-  uint8_t pointInfo = readByteData(FT6336_TD_STATUS);
-  touches = pointInfo;
+bool FT6336::read(void) {
+  if (resetState != READY) {
+    return false;
+  }
+  // Cleared before reading, so an edge during the transfer is not lost
+  bool triggered = interruptPending;
+  uint32_t triggeredAt = interruptMicros;
+  interruptPending = false;
+
+  uint8_t data[FT6336_BURST_SIZE];
+  if (!readBlockData(data, FT6336_TD_STATUS, FT6336_BURST_SIZE)) {
+    stats.errors++;
+    return false;
+  }
+  stats.reads++;
+
+  touches = data[0] & 0x0F;
   isTouched = (touches > 0 && touches < 3);
   if (isTouched) {
     for (uint8_t i=0; i<touches; i++) {
-      readBlockData(data, FT6336_TOUCH_1 + i * 6, 4);
-      points[i] = readPoint(data);
+      points[i] = readPoint(&data[1 + i * 6]);
     }
   }
+
+  if (triggered) {
+    stats.latencyUs = micros() - triggeredAt;
+    if (stats.latencyUs > stats.maxLatencyUs) {
+      stats.maxLatencyUs = stats.latencyUs;
+    }
+  }
+  return true;
 }
 TP_Point FT6336::readPoint(uint8_t *data) {
   uint16_t temp;
@@ -77,17 +139,17 @@ TP_Point FT6336::readPoint(uint8_t *data) {
       break;
     case ROTATION_LEFT:
       temp = x;
-      x = height - y;
+      x = height - 1 - y;
       y = temp;
       break;
     case ROTATION_INVERTED:
-      x = width - x;
-      y = height - y;
+      x = width - 1 - x;
+      y = height - 1 - y;
       break;
     case ROTATION_RIGHT:
       temp = x;
       x = y;
-      y = width - temp;
+      y = width - 1 - temp;
       break;
     default:
       break;
@@ -95,41 +157,40 @@ TP_Point FT6336::readPoint(uint8_t *data) {
   return TP_Point(id, x, y, 0);
 }
 void FT6336::writeByteData(uint16_t reg, uint8_t val) {
-  Wire.beginTransmission(addr);
- // Wire.write(highByte(reg));
-  Wire.write(lowByte(reg));
-  Wire.write(val);
-  Wire.endTransmission();
+  writeBlockData(reg, &val, 1);
 }
 uint8_t FT6336::readByteData(uint16_t reg) {
-  uint8_t x;
-  Wire.beginTransmission(addr);
- // Wire.write(highByte(reg));
-  Wire.write(lowByte(reg));
-  Wire.endTransmission();
-  Wire.requestFrom(addr, (uint8_t)1);
-  x = Wire.read();
+  uint8_t x = 0;
+  readBlockData(&x, reg, 1);
   return x;
 }
-void FT6336::writeBlockData(uint16_t reg, uint8_t *val, uint8_t size) {
+bool FT6336::writeBlockData(uint16_t reg, uint8_t *val, uint8_t size) {
+  if (transportWrite) {
+    return transportWrite(lowByte(reg), val, size, transportCtx);
+  }
   Wire.beginTransmission(addr);
 //  Wire.write(highByte(reg));
   Wire.write(lowByte(reg));
-  // Wire.write(val, size);
-  for (uint8_t i=0; i<size; i++) {
-    Wire.write(val[i]);
-  }
-  Wire.endTransmission();
+  Wire.write(val, size);
+  return Wire.endTransmission() == 0;
 }
-void FT6336::readBlockData(uint8_t *buf, uint16_t reg, uint8_t size) {
+bool FT6336::readBlockData(uint8_t *buf, uint16_t reg, uint8_t size) {
+  if (transportRead) {
+    return transportRead(lowByte(reg), buf, size, transportCtx);
+  }
   Wire.beginTransmission(addr);
 //  Wire.write(highByte(reg));
   Wire.write(lowByte(reg));
-  Wire.endTransmission();
-  Wire.requestFrom(addr, size);
+  if (Wire.endTransmission(false) != 0) {
+    return false;
+  }
+  if (Wire.requestFrom(addr, size) != size) {
+    return false;
+  }
   for (uint8_t i=0; i<size; i++) {
     buf[i] = Wire.read();
   }
+  return true;
 }
 TP_Point::TP_Point(void) {
   id = x = y = size = 0;
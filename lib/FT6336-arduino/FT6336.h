@@ -20,15 +20,25 @@
 
 #define FT6336_TOUCH_REG        {FT6336_TOUCH_1, FT6336_TOUCH_2}
 
+// TD_STATUS plus both 6-byte point records, read in one burst
+#define FT6336_BURST_SIZE   (uint8_t)13
+
 #define FT6336_ID_G_CIPHER_MID    (uint8_t)0x9F    //default: 0x26
 #define FT6336_ID_G_CIPHER_LOW    (uint8_t)0XA0    //0x01:FT6336G, 0x02:FT6336U
 #define FT6336_ID_G_LIB_VERSION   (uint8_t)0xA1
 #define FT6336_ID_G_CIPHER_HIGH     (uint8_t)0XA3  //default: 0x64
-#define FT6336_ID_G_MODE            (uint8_t)0XA4
+#define FT6336_ID_G_MODE            (uint8_t)0XA4  //0: INT held low while touched, 1: INT pulse per report
 #define FT6336_ID_G_FOCALTECH_ID    (uint8_t)0XA8  //default: 0x11
 #define FT6336_ID_G_THGROUP         (uint8_t)0X80
 #define FT6336_ID_G_PERIODACTIVE    (uint8_t)0X88
 
+// Reset timing (datasheet: >= 5 ms low, then up to 300 ms before the first I2C access)
+#define FT6336_RESET_LOW_MS       20
+#define FT6336_RESET_STARTUP_MS   300
+
+// Register transport, so the driver can share a bus it doesn't own. Return true on success.
+typedef bool (*FT6336ReadFn)(uint8_t reg, uint8_t *buf, uint8_t size, void *ctx);
+typedef bool (*FT6336WriteFn)(uint8_t reg, const uint8_t *buf, uint8_t size, void *ctx);
 
 class TP_Point {
   public:
@@ -46,22 +56,49 @@ class TP_Point {
 
 class FT6336 {
   public:
+    enum State : uint8_t { RESET_LOW, STARTING_UP, READY, FAILED };
+
+    struct Stats {
+      uint32_t interrupts;    // Falling edges on INT
+      uint32_t reads;         // Burst reads
+      uint32_t errors;        // Failed reads and failed identification
+      uint32_t latencyUs;     // INT edge to decoded sample, last read
+      uint32_t maxLatencyUs;
+    };
+
     FT6336(uint8_t _sda, uint8_t _scl, uint8_t _int, uint8_t _rst, uint16_t _width, uint16_t _height);
+
+    // Uses Wire directly unless a transport is set first
+    void setTransport(FT6336ReadFn readFn, FT6336WriteFn writeFn, void *ctx);
+    // Called from the INT interrupt, e.g. to wake the task that calls read()
+    void onInterrupt(void (*callback)(void *), void *ctx);
+
+    // Starts the reset sequence and returns immediately; update() finishes it
     void begin(uint8_t _addr=FT6336_ADDR);
-    uint8_t reset();
+    void reset();
+    // Advances the reset sequence. Returns true once the controller is ready.
+    bool update();
+    State state() const { return resetState; }
+
     void setRotation(uint8_t rot);
-    void read(void);
+    // One burst read of status and both points. Returns false if the read failed.
+    bool read(void);
+    // True if INT fired since the last read()
+    bool pending() const { return interruptPending; }
+
     uint8_t touches = 0;
     bool isTouched = false;
     TP_Point points[2];
+    Stats stats = {};
 
   private:
-    // static void ARDUINO_ISR_ATTR onInterrupt();
+    static void ARDUINO_ISR_ATTR onInterruptStatic(void *arg);
+    bool identify();
     TP_Point readPoint(uint8_t *data);
     void writeByteData(uint16_t reg, uint8_t val);
     uint8_t readByteData(uint16_t reg);
-    void writeBlockData(uint16_t reg, uint8_t *val, uint8_t size);
-    void readBlockData(uint8_t *buf, uint16_t reg, uint8_t size);
+    bool writeBlockData(uint16_t reg, uint8_t *val, uint8_t size);
+    bool readBlockData(uint8_t *buf, uint16_t reg, uint8_t size);
     uint8_t rotation = ROTATION_NORMAL;
     uint8_t addr;
     uint8_t pinSda;
@@ -70,6 +107,17 @@ class FT6336 {
     uint8_t pinRst;
     uint16_t width;
     uint16_t height;
+
+    FT6336ReadFn transportRead = nullptr;
+    FT6336WriteFn transportWrite = nullptr;
+    void *transportCtx = nullptr;
+    void (*interruptCallback)(void *) = nullptr;
+    void *interruptCtx = nullptr;
+
+    State resetState = RESET_LOW;
+    uint32_t resetStarted = 0;
+    volatile bool interruptPending = false;
+    volatile uint32_t interruptMicros = 0;
 };
 
-#endif 
+#endif
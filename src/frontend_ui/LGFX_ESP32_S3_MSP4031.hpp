@@ -5,15 +5,16 @@
 
 // This configuration is for the MSP4031 display with an ESP32-S3.
 // Display: 4.0" 320x480 ST7796S (SPI)
-// Touch:   Capacitive FT6336U (I2C)
+// Touch:   Capacitive FT6336U (I2C) - read through i2c_bus, not by LovyanGFX
 
 class LGFX : public lgfx::LGFX_Device
 {
-  // Provide instances for panel, bus, light, and touch.
+  // Provide instances for panel, bus, and light.
+  // The touch controller shares its I2C bus with the TCA9535, so the bus owner
+  // task in i2c_bus.cpp reads it instead of a second driver on the same pins.
   lgfx::Panel_ST7796  _panel_instance;
   lgfx::Bus_SPI       _bus_instance;
   lgfx::Light_PWM     _light_instance;
-  lgfx::Touch_FT5x06  _touch_instance; // FT6336 is compatible with FT5x06 driver
 
 public:
   LGFX(void)
@@ -78,27 +79,6 @@ public:
       _panel_instance.setLight(&_light_instance);
     }
 
-    // Configure the touch control settings (I2C).
-    {
-      auto cfg = _touch_instance.config();
-
-      cfg.i2c_port    = 0;          // I2C port 0 or 1
-      cfg.i2c_addr    = 0x38;       // FT6336U default address
-      cfg.pin_sda     = 41;         // from your touch.h
-      cfg.pin_scl     = 40;         // from your touch.h
-      cfg.pin_int     = 16;         // from your touch.h
-      cfg.pin_rst     = 15;         // from your touch.h
-      cfg.freq        = 400000;     // I2C frequency
-      cfg.x_min       = 0;
-      cfg.x_max       = 319;        // Match panel width - 1
-      cfg.y_min       = 0;
-      cfg.y_max       = 479;        // Match panel height - 1
-      cfg.bus_shared  = false;      // I2C bus is separate from SPI
-
-      _touch_instance.config(cfg);
-      _panel_instance.setTouch(&_touch_instance);
-    }
-    
     setPanel(&_panel_instance);
   }
   void setBacklightFreq(uint32_t freq)
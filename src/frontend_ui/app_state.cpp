@@ -0,0 +1,119 @@
+// src/frontend_ui/app_state.cpp
+
+#include "app_state.h"
+#include "effects.h"
+#include "mqtt.h"
+#include <atomic>
+
+// --- Initial State ---
+constexpr int32_t INITIAL_VALUE = 50;
+constexpr bool    INITIAL_LEDS_ON = false;
+constexpr int     INITIAL_MODE = 0;
+
+// --- Subjects ---
+lv_subject_t state_value;
+lv_subject_t state_leds_on;
+lv_subject_t state_mode;
+
+// --- Snapshot (seqlock) ---
+// Odd sequence: a write is in progress. The fields are atomics so a torn
+// read is merely retried, never undefined.
+static std::atomic<uint32_t> sequence{0};
+static std::atomic<int32_t>  shared_value{INITIAL_VALUE};
+static std::atomic<bool>     shared_leds_on{INITIAL_LEDS_ON};
+static std::atomic<int>      shared_mode{INITIAL_MODE};
+static portMUX_TYPE write_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+/**
+ * @brief Copies the subjects into the snapshot. Runs on every change, whoever made it
+ *        (setters or widget bindings). The critical section keeps a reader on this
+ *        core from preempting a half-done write and spinning on it.
+ */
+static void publish_snapshot(lv_observer_t* observer, lv_subject_t* subject) {
+    portENTER_CRITICAL(&write_lock);
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    shared_value.store(lv_subject_get_int(&state_value), std::memory_order_relaxed);
+    shared_leds_on.store(lv_subject_get_int(&state_leds_on) != 0, std::memory_order_relaxed);
+    shared_mode.store(lv_subject_get_int(&state_mode), std::memory_order_relaxed);
+    sequence.store(seq + 2, std::memory_order_release);
+    portEXIT_CRITICAL(&write_lock);
+}
+
+/**
+ * @brief In the volume mode the value is the player volume; update_volume() ignores it otherwise.
+ */
+static void publish_volume(lv_observer_t* observer, lv_subject_t* subject) {
+    update_volume(lv_subject_get_int(subject));
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in app_state.h)
+// =========================================================================
+
+void app_state_init() {
+    lv_subject_init_int(&state_value, INITIAL_VALUE);
+    lv_subject_init_int(&state_leds_on, INITIAL_LEDS_ON);
+    lv_subject_init_int(&state_mode, INITIAL_MODE);
+
+    lv_subject_add_observer(&state_value, publish_snapshot, NULL);
+    lv_subject_add_observer(&state_leds_on, publish_snapshot, NULL);
+    lv_subject_add_observer(&state_mode, publish_snapshot, NULL);
+
+    lv_subject_add_observer(&state_value, publish_volume, NULL);
+}
+
+int32_t app_state_value() {
+    return lv_subject_get_int(&state_value);
+}
+
+bool app_state_leds_on() {
+    return lv_subject_get_int(&state_leds_on) != 0;
+}
+
+int app_state_mode() {
+    return lv_subject_get_int(&state_mode);
+}
+
+void app_state_set_value(int32_t value) {
+    value = constrain(value, 0, led_mode(app_state_mode()).max_value);
+    if (value != app_state_value()) {
+        lv_subject_set_int(&state_value, value);
+    }
+}
+
+void app_state_set_leds_on(bool on) {
+    if (on != app_state_leds_on()) {
+        lv_subject_set_int(&state_leds_on, on);
+    }
+}
+
+void app_state_set_mode(int mode) {
+    mode = constrain(mode, 0, totalModes - 1);
+    if (mode != app_state_mode()) {
+        lv_subject_set_int(&state_mode, mode);
+        app_state_set_value(app_state_value()); // Into the new mode's range
+    }
+}
+
+void app_state_read(AppStateSnapshot& out) {
+    uint32_t before, after;
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        out.value = shared_value.load(std::memory_order_relaxed);
+        out.leds_on = shared_leds_on.load(std::memory_order_relaxed);
+        out.mode = shared_mode.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    out.version = before / 2;
+}
+
+uint32_t app_state_version() {
+    return sequence.load(std::memory_order_acquire) / 2;
+}
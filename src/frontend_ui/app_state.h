@@ -0,0 +1,65 @@
+// src/frontend_ui/app_state.h
+
+#ifndef APP_STATE_H
+#define APP_STATE_H
+
+#include "globals.h"
+
+// =========================================================================
+// APPLICATION STATE
+// The LED value, power and mode as LVGL subjects. Widgets bind to them and
+// observers react to them, so nothing polls and nothing redraws unless a
+// value actually changed. Set them from the loop() task only.
+//
+// Other tasks read a seqlock-protected copy with app_state_read(): no locks,
+// always consistent, and versioned so they can skip work when nothing changed.
+// =========================================================================
+
+extern lv_subject_t state_value;   // int: encoder/arc value, 0..led_mode(mode).max_value
+extern lv_subject_t state_leds_on; // int: 0 or 1
+extern lv_subject_t state_mode;    // int: index into the mode registry
+
+/**
+ * @brief A consistent copy of the state, for tasks other than loop().
+ */
+struct AppStateSnapshot {
+    uint32_t version; // Increments on every change
+    int32_t  value;
+    bool     leds_on;
+    int      mode;
+};
+
+/**
+ * @brief Initializes the subjects and attaches the volume publishing.
+ *        Call after lvgl_init() and before ui_init().
+ */
+void app_state_init();
+
+int32_t app_state_value();
+bool app_state_leds_on();
+int app_state_mode();
+
+/**
+ * @brief Sets the value, clamped to the current mode's range. Notifies only on change.
+ */
+void app_state_set_value(int32_t value);
+
+void app_state_set_leds_on(bool on);
+
+/**
+ * @brief Switches mode and clamps the value to the new range. Notifies only on change.
+ */
+void app_state_set_mode(int mode);
+
+/**
+ * @brief Lock-free consistent read from any task or core. Retries only while
+ *        the loop() task is in the middle of a change.
+ */
+void app_state_read(AppStateSnapshot& out);
+
+/**
+ * @brief Current version without reading the rest.
+ */
+uint32_t app_state_version();
+
+#endif // APP_STATE_H
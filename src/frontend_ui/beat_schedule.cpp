@@ -0,0 +1,96 @@
+// src/frontend_ui/beat_schedule.cpp
+
+#include "beat_schedule.h"
+
+// --- Configuration ---
+constexpr size_t   BEAT_HEADER_SIZE = 8;
+constexpr uint16_t BEAT_DOWNBEAT_BIT = 0x8000;
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+static uint16_t read_u16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t read_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// =========================================================================
+// SCHEDULE
+// =========================================================================
+
+void BeatSchedule::set_beat(uint16_t i, uint32_t ms, bool is_downbeat) {
+    beat_ms[i] = ms;
+    if (is_downbeat) {
+        downbeat[i / 8] |= 1 << (i % 8);
+    } else {
+        downbeat[i / 8] &= ~(1 << (i % 8));
+    }
+}
+
+BeatDecodeResult beat_schedule_decode(const uint8_t* data, size_t length, BeatSchedule& out) {
+    if (length < BEAT_HEADER_SIZE || data[0] != BEAT_SCHEDULE_VERSION) {
+        return BeatDecodeResult::BadHeader;
+    }
+    uint16_t count = read_u16(data + 2);
+    if (length < BEAT_HEADER_SIZE + (size_t)count * 2) {
+        return BeatDecodeResult::Truncated;
+    }
+
+    uint32_t beat_ms = read_u32(data + 4);
+    out.count = count < BEAT_SCHEDULE_MAX ? count : BEAT_SCHEDULE_MAX;
+    for (uint16_t i = 0; i < out.count; i++) {
+        uint16_t entry = read_u16(data + BEAT_HEADER_SIZE + i * 2);
+        beat_ms += entry & ~BEAT_DOWNBEAT_BIT;
+        out.set_beat(i, beat_ms, entry & BEAT_DOWNBEAT_BIT);
+    }
+    return BeatDecodeResult::Ok;
+}
+
+// =========================================================================
+// CURSOR
+// =========================================================================
+
+/**
+ * @brief Moves to the first beat at or after the position, without firing anything.
+ */
+void BeatCursor::seek(const BeatSchedule& schedule, uint64_t position_us) {
+    uint16_t lo = 0, hi = schedule.count;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (schedule.beat_us(mid) < position_us) lo = mid + 1;
+        else hi = mid;
+    }
+    next_beat_ = lo;
+}
+
+BeatStep BeatCursor::advance(const BeatSchedule& schedule, uint64_t position_us, LatencyHistogram& lateness_us) {
+    BeatStep step = {0, 0, false, 0, BEAT_NONE};
+    if (resync_ || position_us + seek_us_ < last_position_us_ || position_us > last_position_us_ + seek_us_) {
+        seek(schedule, position_us);
+        resync_ = false;
+    }
+    last_position_us_ = position_us;
+
+    while (next_beat_ < schedule.count && schedule.beat_us(next_beat_) <= position_us) {
+        uint32_t late_us = position_us - schedule.beat_us(next_beat_);
+        if (late_us > max_late_us_) {
+            step.skipped++;
+        } else {
+            lateness_us.record(late_us);
+            step.fired++;
+            step.late_us = late_us;
+            step.downbeat = schedule.is_downbeat(next_beat_);
+        }
+        next_beat_++;
+    }
+
+    if (next_beat_ < schedule.count) {
+        uint64_t wait_us = schedule.beat_us(next_beat_) - position_us;
+        step.wait_us = wait_us < BEAT_NONE ? wait_us : BEAT_NONE;
+    }
+    return step;
+}
@@ -0,0 +1,98 @@
+// src/frontend_ui/beat_schedule.h
+
+#ifndef BEAT_SCHEDULE_H
+#define BEAT_SCHEDULE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "latency_histogram.h"
+
+// =========================================================================
+// BEAT SCHEDULE WIRE FORMAT (Config::topic_beats, little endian)
+//
+//   uint8   version    BEAT_SCHEDULE_VERSION
+//   uint8   reserved   0
+//   uint16  count      Beats that follow
+//   uint32  start_ms   Track position the first gap counts from
+//   uint16  beats[count]
+//           bits 0-14: ms after the previous beat (the first one: after start_ms)
+//           bit 15:    the beat starts a bar
+//
+// A schedule covers a window of the track and replaces the previous one.
+// Compute each gap from rounded absolute times, not a rounded beat period,
+// so rounding doesn't add up over the window.
+// =========================================================================
+
+constexpr uint8_t  BEAT_SCHEDULE_VERSION = 1;
+constexpr size_t   BEAT_SCHEDULE_MAX = 256;     // Beats kept per schedule; the rest are ignored
+constexpr uint32_t BEAT_NONE = UINT32_MAX;      // Nothing scheduled
+
+/**
+ * @brief A decoded schedule: absolute track positions and a downbeat bit per beat.
+ */
+struct BeatSchedule {
+    uint32_t beat_ms[BEAT_SCHEDULE_MAX];
+    uint8_t  downbeat[BEAT_SCHEDULE_MAX / 8];
+    uint16_t count;
+
+    uint64_t beat_us(uint16_t i) const { return (uint64_t)beat_ms[i] * 1000; }
+    bool is_downbeat(uint16_t i) const { return downbeat[i / 8] & (1 << (i % 8)); }
+    void set_beat(uint16_t i, uint32_t ms, bool is_downbeat);
+};
+
+enum class BeatDecodeResult : uint8_t {
+    Ok,
+    BadHeader,  // Too short for the header, or an unknown version
+    Truncated,  // Fewer beats than the header's count
+};
+
+/**
+ * @brief Decodes a wire-format payload. Beats past BEAT_SCHEDULE_MAX are dropped.
+ *        out is only complete when the result is Ok.
+ */
+BeatDecodeResult beat_schedule_decode(const uint8_t* data, size_t length, BeatSchedule& out);
+
+/**
+ * @brief What one BeatCursor::advance() did.
+ */
+struct BeatStep {
+    uint16_t fired;     // Beats that came due in time to show
+    uint16_t skipped;   // Beats that came due too late
+    bool     downbeat;  // Of the last fired beat
+    uint32_t late_us;   // Of the last fired beat
+    uint32_t wait_us;   // Until the next beat, or BEAT_NONE
+};
+
+/**
+ * @brief Walks a schedule along the playback clock. A position that jumps by
+ *        more than seek_us, in either direction, is a seek: the cursor moves
+ *        to the next beat by binary search without firing the ones in between.
+ */
+class BeatCursor {
+public:
+    BeatCursor(uint32_t max_late_us, uint64_t seek_us) : max_late_us_(max_late_us), seek_us_(seek_us) {}
+
+    /**
+     * @brief Makes the next advance() seek, e.g. for a new schedule or after a pause.
+     */
+    void resync() { resync_ = true; }
+
+    /**
+     * @brief Fires every beat due at the position.
+     * @param lateness_us Gets the lateness of every fired beat.
+     */
+    BeatStep advance(const BeatSchedule& schedule, uint64_t position_us, LatencyHistogram& lateness_us);
+
+    uint16_t next_beat() const { return next_beat_; }
+
+private:
+    void seek(const BeatSchedule& schedule, uint64_t position_us);
+
+    uint32_t max_late_us_;
+    uint64_t seek_us_;
+    uint16_t next_beat_ = 0;
+    bool     resync_ = true;
+    uint64_t last_position_us_ = 0;
+};
+
+#endif // BEAT_SCHEDULE_H
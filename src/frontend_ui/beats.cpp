@@ -0,0 +1,124 @@
+// src/frontend_ui/beats.cpp
+
+#include "beats.h"
+#include "config.h"
+#include "mqtt.h"
+#include "playback.h"
+
+// --- Configuration ---
+constexpr uint32_t BEAT_MAX_LATE_US = 50000;  // Later than this and the flash would look off-beat
+constexpr uint64_t BEAT_SEEK_US = 250000;     // Position jumps larger than this are seeks
+constexpr uint32_t SYNTHETIC_LEAD_MS = 500;
+
+// --- State Variables ---
+// Filled by the MQTT handler (loop task), taken by the LED task
+static portMUX_TYPE incoming_lock = portMUX_INITIALIZER_UNLOCKED;
+static BeatSchedule incoming;
+static bool incoming_ready = false;
+
+// LED task only
+static BeatSchedule active;
+static BeatCursor cursor(BEAT_MAX_LATE_US, BEAT_SEEK_US);
+static uint32_t pulse_us = 0;
+static bool pulse_downbeat = false;
+static bool pulse_valid = false;
+
+static BeatStats stats = {};
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+/**
+ * @brief Hands a decoded schedule to the LED task. Replaces one it hasn't taken yet.
+ */
+static void publish_schedule(const BeatSchedule& schedule) {
+    portENTER_CRITICAL(&incoming_lock);
+    memcpy(&incoming, &schedule, sizeof(incoming));
+    incoming_ready = true;
+    portEXIT_CRITICAL(&incoming_lock);
+    stats.schedules++;
+}
+
+static void take_incoming() {
+    if (!incoming_ready) return;
+    portENTER_CRITICAL(&incoming_lock);
+    memcpy(&active, &incoming, sizeof(active));
+    incoming_ready = false;
+    portEXIT_CRITICAL(&incoming_lock);
+    cursor.resync();
+}
+
+static void handle_beats_message(const char* payload, unsigned int length) {
+    static BeatSchedule decoded; // Static: 1 KB is too much for the loop stack
+    const uint8_t* data = (const uint8_t*)payload;
+
+    switch (beat_schedule_decode(data, length, decoded)) {
+        case BeatDecodeResult::Ok:
+            break;
+        case BeatDecodeResult::BadHeader:
+            stats.rejected++;
+            Serial.printf("[Beats] Rejected schedule (%u bytes)\n", length);
+            return;
+        case BeatDecodeResult::Truncated:
+            stats.rejected++;
+            Serial.printf("[Beats] Truncated schedule: %u beats in %u bytes\n", data[2] | (data[3] << 8), length);
+            return;
+    }
+    publish_schedule(decoded);
+
+    #ifdef DEBUG_MQTT
+        Serial.printf("[Beats] Schedule of %u beats, first at %u ms\n", decoded.count, decoded.count ? (unsigned)decoded.beat_ms[0] : 0);
+    #endif
+}
+
+static constexpr MqttTopic beats_topic = mqtt_topic(Config::topic_beats, MqttPayload::Binary, handle_beats_message);
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in beats.h)
+// =========================================================================
+
+void beats_init() {
+    mqtt_register_topic(beats_topic);
+}
+
+uint32_t beats_poll() {
+    take_incoming();
+    if (active.count == 0 || !playback_is_playing()) {
+        cursor.resync(); // Pick up wherever playback resumes
+        return BEAT_NONE;
+    }
+
+    BeatStep step = cursor.advance(active, playback_position_us(), stats.lateness_us);
+    stats.fired += step.fired;
+    stats.skipped += step.skipped;
+    if (step.fired > 0) {
+        pulse_us = micros() - step.late_us;
+        pulse_downbeat = step.downbeat;
+        pulse_valid = true;
+    }
+    return step.wait_us;
+}
+
+BeatPulse beats_last_pulse() {
+    return BeatPulse{pulse_valid, pulse_downbeat, (micros() - pulse_us) / 1000};
+}
+
+void beats_load_synthetic(uint16_t bpm, uint8_t beats_per_bar) {
+    static BeatSchedule synthetic;
+    bpm = constrain(bpm, 20, 300);
+    if (beats_per_bar == 0) beats_per_bar = 1;
+
+    uint32_t start_ms = playback_position_ms() + SYNTHETIC_LEAD_MS;
+    synthetic.count = BEAT_SCHEDULE_MAX;
+    for (uint16_t i = 0; i < synthetic.count; i++) {
+        // Rounded from the absolute time, like the bridge does
+        synthetic.set_beat(i, start_ms + (uint32_t)((uint64_t)i * 60000 / bpm), i % beats_per_bar == 0);
+    }
+    publish_schedule(synthetic);
+    Serial.printf("[Beats] Synthetic schedule: %u bpm from %u ms\n", bpm, (unsigned)start_ms);
+}
+
+BeatStats& beats_get_stats() {
+    return stats;
+}
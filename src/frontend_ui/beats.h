@@ -0,0 +1,60 @@
+// src/frontend_ui/beats.h
+
+#ifndef BEATS_H
+#define BEATS_H
+
+#include <Arduino.h>
+#include "beat_schedule.h" // Wire format and the schedule walk
+
+/**
+ * @brief Beat scheduler counters.
+ */
+struct BeatStats {
+    uint32_t schedules;   // Schedules accepted
+    uint32_t rejected;    // Malformed payloads
+    uint32_t fired;       // Beats delivered to the LEDs
+    uint32_t skipped;     // Beats that came due too late to be worth showing
+    LatencyHistogram lateness_us; // Playback clock at firing minus beat time
+};
+
+/**
+ * @brief The most recent beat, for effects to animate from.
+ */
+struct BeatPulse {
+    bool     valid;    // false until a beat has fired
+    bool     downbeat; // First beat of a bar
+    uint32_t age_ms;   // Time since the beat was due
+};
+
+/**
+ * @brief Registers Config::topic_beats. Call once from setup().
+ */
+void beats_init();
+
+/**
+ * @brief Fires every beat that is due on the playback clock. Runs in the LED task,
+ *        before each frame. Seeks and pauses are followed automatically.
+ * @return Microseconds until the next beat is due, or BEAT_NONE.
+ */
+uint32_t beats_poll();
+
+/**
+ * @brief The last beat fired by beats_poll().
+ */
+BeatPulse beats_last_pulse();
+
+/**
+ * @brief Loads an evenly spaced schedule starting just ahead of the current
+ *        position, e.g. to measure timing without the music bridge. Reachable
+ *        as the "beat_test [bpm]" command when DEBUG_BEATS is defined.
+ * @param bpm Tempo, 20-300.
+ * @param beats_per_bar Beats between downbeats.
+ */
+void beats_load_synthetic(uint16_t bpm, uint8_t beats_per_bar);
+
+/**
+ * @brief Scheduler counters. Reset lateness_us after reporting it.
+ */
+BeatStats& beats_get_stats();
+
+#endif // BEATS_H
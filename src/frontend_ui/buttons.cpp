@@ -0,0 +1,153 @@
+// src/frontend_ui/buttons.cpp
+
+#include "buttons.h"
+
+// --- Configuration ---
+constexpr uint8_t MAX_BUTTON_LISTENERS = 4;
+
+// --- State Variables ---
+struct ButtonState {
+    ButtonConfig config;
+    bool     raw_pressed;      // Level after the most recent raw edge
+    uint32_t raw_us;
+    bool     pressed;          // Debounced level
+    uint32_t changed_us;       // When the debounced level last changed
+    uint32_t press_us;         // Start of the current press
+    bool     long_fired;       // This press already produced a LongPress
+    uint32_t next_repeat_us;
+    uint16_t repeats;
+    uint8_t  clicks;           // Clicks waiting for the double-click window
+    uint32_t release_us;
+};
+
+struct ListenerSlot {
+    ButtonListener listener;
+    void* ctx;
+};
+
+static ButtonState buttons[BUTTON_COUNT] = {
+    {BUTTON_CONFIG_DEFAULT}, {BUTTON_CONFIG_DEFAULT}, {BUTTON_CONFIG_DEFAULT},
+};
+static ListenerSlot listeners[MAX_BUTTON_LISTENERS] = {};
+static uint32_t bounces = 0;
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+static void post(InputButton button, ButtonAction action, uint32_t time_us, uint16_t repeat = 0) {
+    ButtonEvent event = {time_us, button, action, repeat};
+    for (const ListenerSlot& slot : listeners) {
+        if (slot.listener) slot.listener(event, slot.ctx);
+    }
+}
+
+/**
+ * @brief A debounced level change: emits Press/Release and counts clicks.
+ */
+static void accept(InputButton id, bool pressed, uint32_t time_us) {
+    ButtonState& b = buttons[id];
+    b.pressed = pressed;
+    b.changed_us = time_us;
+
+    if (pressed) {
+        b.press_us = time_us;
+        b.long_fired = false;
+        b.repeats = 0;
+        b.next_repeat_us = time_us + b.config.repeat_delay_us;
+        post(id, ButtonAction::Press, time_us);
+        return;
+    }
+
+    post(id, ButtonAction::Release, time_us);
+    if (b.long_fired || b.repeats > 0) {
+        b.clicks = 0; // A hold is not a click
+        return;
+    }
+    if (b.config.double_click_us == 0) {
+        post(id, ButtonAction::Click, time_us);
+        return;
+    }
+    if (++b.clicks >= 2) {
+        b.clicks = 0;
+        post(id, ButtonAction::DoubleClick, time_us);
+        return;
+    }
+    b.release_us = time_us;
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in buttons.h)
+// =========================================================================
+
+void buttons_configure(InputButton button, const ButtonConfig& config) {
+    buttons[button] = ButtonState{config};
+}
+
+bool buttons_subscribe(ButtonListener listener, void* ctx) {
+    for (ListenerSlot& slot : listeners) {
+        if (slot.listener == nullptr) {
+            slot.listener = listener;
+            slot.ctx = ctx;
+            return true;
+        }
+    }
+    return false;
+}
+
+void buttons_feed(const InputEvent& event) {
+    if ((event.type != InputEventType::ButtonDown && event.type != InputEventType::ButtonUp) || event.id >= BUTTON_COUNT) {
+        return;
+    }
+    InputButton id = (InputButton)event.id;
+    ButtonState& b = buttons[id];
+    b.raw_pressed = (event.type == InputEventType::ButtonDown);
+    b.raw_us = event.time_us;
+
+    // The first edge after a quiet period counts at once; edges inside the
+    // window are bounce, and buttons_tick() takes the level they settle on
+    if (event.time_us - b.changed_us < b.config.debounce_us) {
+        bounces++;
+        return;
+    }
+    if (b.raw_pressed != b.pressed) {
+        accept(id, b.raw_pressed, event.time_us);
+    }
+}
+
+void buttons_tick(uint32_t now_us) {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        InputButton id = (InputButton)i;
+        ButtonState& b = buttons[i];
+
+        // A bounce that ended on a different level than the one accepted
+        if (b.raw_pressed != b.pressed && now_us - b.changed_us >= b.config.debounce_us) {
+            accept(id, b.raw_pressed, b.raw_us);
+        }
+
+        if (b.pressed) {
+            uint32_t held = now_us - b.press_us;
+            if (b.config.long_press_us && !b.long_fired && held >= b.config.long_press_us) {
+                b.long_fired = true;
+                b.clicks = 0;
+                post(id, ButtonAction::LongPress, now_us);
+            }
+            if (b.config.repeat_interval_us && (int32_t)(now_us - b.next_repeat_us) >= 0) {
+                b.next_repeat_us += b.config.repeat_interval_us;
+                post(id, ButtonAction::Repeat, now_us, ++b.repeats);
+            }
+        } else if (b.clicks > 0 && now_us - b.release_us >= b.config.double_click_us) {
+            // No second click came
+            b.clicks = 0;
+            post(id, ButtonAction::Click, b.release_us);
+        }
+    }
+}
+
+bool buttons_is_pressed(InputButton button) {
+    return buttons[button].pressed;
+}
+
+uint32_t buttons_bounce_count() {
+    return bounces;
+}
@@ -0,0 +1,73 @@
+// src/frontend_ui/buttons.h
+
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdint.h>
+#include "input_events.h"
+
+enum class ButtonAction : uint8_t {
+    Press,        // Debounced down
+    Release,      // Debounced up
+    Click,        // Short press; delayed by double_click_us if double clicks are enabled
+    DoubleClick,
+    LongPress,    // Held for long_press_us, once per press
+    Repeat,       // While held, after repeat_delay_us, every repeat_interval_us
+};
+
+struct ButtonEvent {
+    uint32_t     time_us;
+    InputButton  button;
+    ButtonAction action;
+    uint16_t     repeat;  // 1, 2, ... for Repeat
+};
+
+/**
+ * @brief Timing for one button. A zero time disables that action.
+ */
+struct ButtonConfig {
+    uint32_t debounce_us;
+    uint32_t long_press_us;
+    uint32_t double_click_us;     // Window for the second click
+    uint32_t repeat_delay_us;     // First repeat after this long held
+    uint32_t repeat_interval_us;
+};
+
+constexpr ButtonConfig BUTTON_CONFIG_DEFAULT = {5000, 600000, 0, 0, 0};
+
+typedef void (*ButtonListener)(const ButtonEvent& event, void* ctx);
+
+/**
+ * @brief Sets the timing for a button and forgets its state, as if released.
+ *        Call before feeding events.
+ */
+void buttons_configure(InputButton button, const ButtonConfig& config);
+
+/**
+ * @brief Adds a listener for every button event. Up to 4; no allocation.
+ * @return false if all slots are taken.
+ */
+bool buttons_subscribe(ButtonListener listener, void* ctx);
+
+/**
+ * @brief Feeds a raw ButtonDown/ButtonUp edge from the input task. Other events are ignored.
+ */
+void buttons_feed(const InputEvent& event);
+
+/**
+ * @brief Fires time-based actions (settled bounces, long press, repeat, click
+ *        after the double-click window). Call every loop() pass.
+ */
+void buttons_tick(uint32_t now_us);
+
+/**
+ * @brief Debounced state.
+ */
+bool buttons_is_pressed(InputButton button);
+
+/**
+ * @brief Raw edges ignored as switch bounce.
+ */
+uint32_t buttons_bounce_count();
+
+#endif // BUTTONS_H
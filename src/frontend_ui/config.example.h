@@ -2,11 +2,9 @@
 #define CONFIG_H
 // #define DEBUG_MQTT // Uncomment to enable verbose MQTT debug output
 
+// Plain constants only: the native tests include this file too, so keep
+// display and LED library headers out (globals.h pulls those in).
 #include <Arduino.h>
-#include <lvgl.h>
-#include "LGFX_ESP32_S3_MSP4031.hpp"
-#include "FastLED.h"
-#include "TCA9555.h"
 
 // =========================================================================
 // APPLICATION CONFIGURATION (Passwords, Keys, etc.)
@@ -21,13 +19,31 @@ namespace Config {
     constexpr uint16_t    broker_port = 1883;
     constexpr const char* broker_user = ""; // add your username if needed
     constexpr const char* broker_pass = ""; // add your password if needed
+    constexpr uint32_t    mqtt_backoff_min_ms = 1000;  // First retry delay after a failed connect
+    constexpr uint32_t    mqtt_backoff_max_ms = 60000; // Retry delay cap while the broker stays down
+    constexpr bool        mqtt_persistent_session = true; // Keep subscriptions on the broker across reconnects
+    constexpr size_t      mqtt_payload_capacity = 16 * 1024; // Largest payload received (PSRAM); larger ones are dropped
 
     // --- MQTT Topics ---
     constexpr const char* topic_status           = "esp-gui/status";
     constexpr const char* topic_command          = "esp-gui/command";
     constexpr const char* topic_brightness       = "esp-gui/brightness";
+    constexpr const char* topic_telemetry        = "esp-gui/telemetry";  // Retained device health report, one subtopic per section
+    constexpr const char* topic_button           = "esp-gui/button";     // Button actions, e.g. "mode double"
     constexpr const char* topic_image            = "music/image";
+    constexpr const char* topic_music            = "music/status";       // Track length and elapsed time
+    constexpr const char* topic_beats            = "music/beats";        // Binary beat schedule, see beats.h
     constexpr const char* topic_position_set     = "music/position/set"; // Topic to publish elapsed time to
+    constexpr const char* topic_volume_set       = "music/volume/set";   // Topic to publish volume to
+
+    // --- MQTT Publishing ---
+    constexpr uint32_t publish_min_interval_ms = 150; // Rate limit for seek/volume updates while dragging or spinning
+
+    // --- Telemetry ---
+    constexpr uint32_t telemetry_interval_ms = 30000;
+
+    // --- Time Sync ---
+    constexpr const char* ntp_server = "pool.ntp.org"; // Used to compensate music status delivery delay
 
     // --- Spotify Credentials ---
     // You need to create an app in the Spotify Developer Dashboard
@@ -50,11 +66,22 @@ namespace HW {
     constexpr int     NUM_LEDS     = 12;
     #define LED_TYPE    WS2812B
     #define COLOR_ORDER GRB
+    constexpr uint32_t LED_FPS     = 60;  // Render rate of the LED task
+    constexpr uint32_t LED_EFFECT_BUDGET_US = 200; // Time one effect may take to render the whole ring
+    constexpr uint32_t LED_FRAME_BUDGET_US  = 400; // Effect plus crossfade and dithering, before show()
+    constexpr uint32_t LED_CROSSFADE_MS     = 400; // Fade on mode changes and on/off
 
     // --- I2C ---
     constexpr uint8_t I2C_SDA_PIN = 41;
     constexpr uint8_t I2C_SCL_PIN = 40;
     constexpr uint8_t TCA_I2C_ADDR = 0x20;
+    constexpr uint8_t TCA_INT_PIN  = 18; // TCA9535 INT (open-drain, active low)
+    constexpr uint32_t I2C_FREQ_HZ = 400000;
+
+    // --- Touch (FT6336U, on the I2C bus above) ---
+    constexpr uint8_t TOUCH_I2C_ADDR = 0x38;
+    constexpr uint8_t TOUCH_INT_PIN  = 16;
+    constexpr uint8_t TOUCH_RST_PIN  = 15;
 
     // --- I/O Expander Pin Assignments ---
     constexpr uint8_t ENCODER_A_PIN   = 0;
@@ -62,6 +89,11 @@ namespace HW {
     constexpr uint8_t ENCODER_SW_PIN  = 2;
     constexpr uint8_t BUTTON_1_PIN    = 3; // Back Switch
     constexpr uint8_t BUTTON_2_PIN    = 4; // Mode Switch
+
+    // --- Encoder Decoding ---
+    constexpr uint8_t  ENCODER_STEPS_PER_DETENT = 4;     // Quadrature states per click
+    constexpr uint32_t ENCODER_ACCEL_WINDOW_US  = 40000; // Clicks closer together than this are accelerated
+    constexpr uint8_t  ENCODER_ACCEL_MAX        = 8;     // Steps per click at full speed
 }
 
 #endif // CONFIG_H
\ No newline at end of file
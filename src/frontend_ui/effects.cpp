@@ -0,0 +1,183 @@
+// src/frontend_ui/effects.cpp
+
+#include "effects.h"
+#include "config.h"
+#include "led_math.h"
+#include <utility>
+
+// --- Effect Tuning ---
+constexpr uint16_t LED_LEVEL_NORMAL = 200 * 257; // Ring brightness of the modes without their own, 16-bit
+constexpr uint32_t BREATH_PERIOD_SLOW_MS = 6000;
+constexpr uint32_t BREATH_PERIOD_FAST_MS = 1000;
+constexpr uint32_t COMET_LAP_MS = 1500;
+constexpr uint16_t COMET_TAIL_LEDS = 4;
+constexpr uint32_t SPARKLE_FADE_MS = 400;  // Full to dark
+constexpr uint32_t SPARKLE_ODDS = 4000;    // value / SPARKLE_ODDS sparks per LED per ms
+constexpr uint32_t BEAT_FLASH_MS = 180;    // Decay of one beat flash
+
+// --- State Variables ---
+static BeatPulse beat_pulse = {}; // Set by led_mode_set_beat() before each frame
+
+// =========================================================================
+// EFFECTS
+// =========================================================================
+
+static void fill(CRGB* leds, uint16_t count, const CRGB& color) {
+    for (uint16_t i = 0; i < count; i++) leds[i] = color;
+}
+
+// --- Static modes ---
+
+static uint16_t render_brightness(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    fill(leds, count, CRGB::Wheat);
+    // 16-bit so low settings fade smoothly instead of in 1/255 steps
+    return constrain(value, 0, 100) * 65535 / 100;
+}
+
+static uint16_t render_hue(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    fill(leds, count, CHSV(value, 255, 255));
+    return LED_LEVEL_NORMAL;
+}
+
+static uint16_t render_position(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    fill(leds, count, CRGB::Black);
+    leds[constrain(value, 0, count - 1)] = CRGB::Red;
+    return LED_LEVEL_NORMAL;
+}
+
+static uint16_t render_volume(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    fill(leds, count, CRGB::Blue);
+    return 0;
+}
+
+// --- Animated effects ---
+
+/**
+ * @brief Whole ring fades in and out on a sine; value 0-100 sets the pace.
+ */
+static uint16_t render_breathing(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    uint32_t period = BREATH_PERIOD_SLOW_MS - (BREATH_PERIOD_SLOW_MS - BREATH_PERIOD_FAST_MS) * value / 100;
+    uint8_t phase = (now_ms % period) * 256 / period;
+    // Fade through the 16-bit brightness: gamma_u8() would step visibly near dark
+    uint32_t level = led_math::sine_u8(phase) * 257;
+    level = level * level >> 16; // Gamma 2
+    fill(leds, count, CRGB::Wheat);
+    return level * LED_LEVEL_NORMAL >> 16;
+}
+
+/**
+ * @brief A full rainbow spread over the ring, rotating; value 0-100 sets the speed.
+ */
+static uint16_t render_rainbow(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    uint8_t offset = ((uint64_t)now_ms * (value + 1)) >> 6;
+    uint16_t spacing = 256 / count; // Hue steps per LED (8.0 fixed point)
+    for (uint16_t i = 0; i < count; i++) {
+        leds[i] = CHSV(offset + i * spacing, 255, 255);
+    }
+    return LED_LEVEL_NORMAL;
+}
+
+/**
+ * @brief A bright head circling the ring with a fading tail; value 0-255 is the hue.
+ *        Positions are 8.8 fixed point so the head moves smoothly between LEDs.
+ */
+static uint16_t render_comet(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    uint32_t lap = (uint32_t)count << 8;
+    uint32_t head = (uint64_t)(now_ms % COMET_LAP_MS) * lap / COMET_LAP_MS;
+    uint32_t tail = COMET_TAIL_LEDS << 8;
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t behind = (head + lap - ((uint32_t)i << 8)) % lap;
+        uint8_t level = behind < tail ? 255 - behind * 255 / tail : 0;
+        leds[i] = CHSV(value, 255, led_math::gamma_u8(level));
+    }
+    return LED_LEVEL_NORMAL;
+}
+
+/**
+ * @brief White sparks that pop up at random and fade; value 0-100 sets how many.
+ *        Decay and spawn odds scale with the frame interval, so the look doesn't depend on FPS.
+ */
+static uint16_t render_sparkle(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    static uint8_t levels[HW::NUM_LEDS] = {};
+    static uint32_t last_ms = 0;
+    static uint32_t rng = 0x9E3779B9;
+
+    uint32_t dt = now_ms - last_ms;
+    if (dt > SPARKLE_FADE_MS) dt = SPARKLE_FADE_MS;
+    last_ms = now_ms;
+    uint8_t decay = dt * 255 / SPARKLE_FADE_MS;
+
+    for (uint16_t i = 0; i < count && i < HW::NUM_LEDS; i++) {
+        // xorshift32: cheap and deterministic
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        levels[i] = levels[i] > decay ? levels[i] - decay : 0;
+        if (rng % SPARKLE_ODDS < (uint32_t)value * dt) levels[i] = 255;
+        uint8_t level = led_math::gamma_u8(levels[i]);
+        leds[i] = CRGB(level, level, level);
+    }
+    return LED_LEVEL_NORMAL;
+}
+
+/**
+ * @brief Flashes the ring on every scheduled beat (see beats.h); value 0-255 is the hue.
+ *        Downbeats flash paler so the bars stand out. Dark without a schedule.
+ */
+static uint16_t render_beat(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    uint8_t level = 0;
+    if (beat_pulse.valid && beat_pulse.age_ms < BEAT_FLASH_MS) {
+        level = 255 - beat_pulse.age_ms * 255 / BEAT_FLASH_MS;
+    }
+    fill(leds, count, CHSV(value, beat_pulse.downbeat ? 128 : 255, led_math::gamma_u8(level)));
+    return LED_LEVEL_NORMAL;
+}
+
+// =========================================================================
+// REGISTRY
+// =========================================================================
+
+// Order is the order the mode button walks through
+static constexpr LedMode LED_MODES[] = {
+    {"Brightness", 100,               false, false, render_brightness},
+    {"Color Hue",  255,               false, false, render_hue},
+    {"Position",   HW::NUM_LEDS - 1,  false, false, render_position},
+    {"Volume",     100,               true,  false, render_volume},
+    {"Breathing",  100,               false, true,  render_breathing},
+    {"Rainbow",    100,               false, true,  render_rainbow},
+    {"Comet",      255,               false, true,  render_comet},
+    {"Sparkle",    100,               false, true,  render_sparkle},
+    {"Beat",       255,               false, true,  render_beat},
+};
+constexpr size_t LED_MODE_COUNT = sizeof(LED_MODES) / sizeof(LED_MODES[0]);
+
+template <size_t... I>
+constexpr std::array<const char*, sizeof...(I)> mode_names(std::index_sequence<I...>) {
+    return {{LED_MODES[I].name...}};
+}
+
+static constexpr std::array<const char*, LED_MODE_COUNT> MODE_NAMES = mode_names(std::make_index_sequence<LED_MODE_COUNT>());
+
+// Declared in effects.h
+const char* const* const modeNames = MODE_NAMES.data();
+const int totalModes = LED_MODE_COUNT;
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in effects.h)
+// =========================================================================
+
+const LedMode& led_mode(int index) {
+    return LED_MODES[constrain(index, 0, (int)LED_MODE_COUNT - 1)];
+}
+
+void led_mode_set_beat(const BeatPulse& pulse) {
+    beat_pulse = pulse;
+}
+
+uint16_t led_mode_render(int index, CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value) {
+    if (index < 0 || index >= (int)LED_MODE_COUNT) {
+        fill(leds, count, CRGB::Black);
+        return 0;
+    }
+    return LED_MODES[index].render(leds, count, now_ms, value);
+}
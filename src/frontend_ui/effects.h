@@ -0,0 +1,51 @@
+// src/frontend_ui/effects.h
+
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <Arduino.h>
+#include "FastLED.h"
+#include "beats.h"
+
+/**
+ * @brief Renders one frame into leds[].
+ * @param now_ms Animation clock.
+ * @param value The encoder value for this mode, 0..max_value.
+ * @return Ring brightness, 0-65535. The LED pipeline applies it at 16 bits.
+ */
+typedef uint16_t (*LedRenderFn)(CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value);
+
+/**
+ * @brief One entry of the mode registry. The encoder and arc cycle through these;
+ *        modeNames and totalModes are generated from the table.
+ */
+struct LedMode {
+    const char* name;
+    int32_t     max_value;   // Encoder/arc range is 0..max_value
+    bool        controls_volume; // The encoder sets the player volume instead of the LEDs
+    bool        animated;    // Changes over time; static modes only re-render when the state changes
+    LedRenderFn render;
+};
+
+// Generated from the registry, in button order
+extern const int totalModes;
+extern const char* const* const modeNames;
+
+/**
+ * @brief The registered mode at an index (0..totalModes-1).
+ */
+const LedMode& led_mode(int index);
+
+/**
+ * @brief Hands the effects the latest beat (see beats_last_pulse()). Call before
+ *        led_mode_render(); the "Beat" mode flashes from it.
+ */
+void led_mode_set_beat(const BeatPulse& pulse);
+
+/**
+ * @brief Renders the given mode. Out-of-range indices clear the ring.
+ * @return Ring brightness, 0-65535.
+ */
+uint16_t led_mode_render(int index, CRGB* leds, uint16_t count, uint32_t now_ms, int32_t value);
+
+#endif // EFFECTS_H
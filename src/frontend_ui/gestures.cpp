@@ -0,0 +1,74 @@
+// src/frontend_ui/gestures.cpp
+
+#include "gestures.h"
+#include <stdlib.h>
+
+GestureResult GestureRecognizer::feed(const TouchSample& sample) {
+    GestureResult result = {Gesture::None, 0, start_x_, start_y_};
+
+    // --- All fingers lifted: a quick horizontal stroke is a swipe ---
+    if (sample.count == 0) {
+        if (state_ == State::Tracking) {
+            int16_t dx = last_x_ - start_x_;
+            int16_t dy = last_y_ - start_y_;
+            uint32_t duration = sample.time_us - start_us_;
+            if (abs(dx) >= config_.swipe_min_px && abs(dx) > 2 * abs(dy) && duration <= config_.swipe_max_us) {
+                result.gesture = dx < 0 ? Gesture::SwipeLeft : Gesture::SwipeRight;
+            }
+        }
+        state_ = State::Idle;
+        return result;
+    }
+
+    // --- A second finger turns any one-finger gesture in progress into a volume drag ---
+    if (sample.count >= 2) {
+        int16_t mid_y = (sample.y[0] + sample.y[1]) / 2;
+        if (state_ == State::Idle || state_ == State::Tracking) {
+            if (state_ == State::Idle) {
+                start_x_ = result.start_x = sample.x[0];
+                start_y_ = result.start_y = sample.y[0];
+            }
+            state_ = State::TwoFinger;
+            anchor_y_ = mid_y;
+            return result;
+        }
+        if (state_ == State::TwoFinger) {
+            // Screen y grows downwards; dragging up is louder
+            int16_t steps = (anchor_y_ - mid_y) / config_.volume_px_per_step;
+            if (steps != 0) {
+                anchor_y_ -= steps * config_.volume_px_per_step;
+                result.gesture = Gesture::VolumeDrag;
+                result.value = steps;
+            }
+        }
+        return result;
+    }
+
+    // --- One finger ---
+    switch (state_) {
+        case State::Idle:
+            state_ = State::Tracking;
+            start_us_ = sample.time_us;
+            start_x_ = last_x_ = result.start_x = sample.x[0];
+            start_y_ = last_y_ = result.start_y = sample.y[0];
+            moved_ = false;
+            break;
+
+        case State::Tracking:
+            last_x_ = sample.x[0];
+            last_y_ = sample.y[0];
+            if (abs(last_x_ - start_x_) > config_.touch_slop_px || abs(last_y_ - start_y_) > config_.touch_slop_px) {
+                moved_ = true;
+            }
+            if (!moved_ && sample.time_us - start_us_ >= config_.long_press_us) {
+                state_ = State::Done;
+                result.gesture = Gesture::LongPress;
+            }
+            break;
+
+        default:
+            // One finger left after a two-finger drag, or after a long press: ignore until release
+            break;
+    }
+    return result;
+}
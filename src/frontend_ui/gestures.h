@@ -0,0 +1,79 @@
+// src/frontend_ui/gestures.h
+
+#ifndef GESTURES_H
+#define GESTURES_H
+
+#include <stdint.h>
+
+/**
+ * @brief One raw sample from the touch controller: up to two points.
+ */
+struct TouchSample {
+    uint32_t time_us;
+    uint8_t  count;   // Fingers down, 0-2
+    int16_t  x[2];
+    int16_t  y[2];
+};
+
+enum class Gesture : uint8_t {
+    None,
+    SwipeLeft,    // Finger moved right to left
+    SwipeRight,   // Finger moved left to right
+    LongPress,    // One finger held still
+    VolumeDrag,   // Two fingers moved vertically; value = steps, positive = up
+};
+
+struct GestureResult {
+    Gesture gesture;
+    int16_t value;
+    int16_t start_x; // Where the stroke's first finger came down, so the
+    int16_t start_y; // caller can leave strokes on widgets to the UI
+};
+
+/**
+ * @brief Thresholds in screen pixels and microseconds.
+ */
+struct GestureConfig {
+    int16_t  touch_slop_px      = 12;     // Movement still counted as holding still
+    int16_t  swipe_min_px       = 80;     // Horizontal travel for a swipe
+    uint32_t swipe_max_us       = 500000; // Slower than this is a drag, not a swipe
+    uint32_t long_press_us      = 600000;
+    int16_t  volume_px_per_step = 8;      // Two-finger travel per volume step
+};
+
+/**
+ * @brief Recognizes swipes, long presses and two-finger volume drags from the
+ *        raw sample stream. Keeps a handful of fields, no history: every sample
+ *        costs the same, and the result depends only on the samples fed in.
+ */
+class GestureRecognizer {
+public:
+    explicit GestureRecognizer(const GestureConfig& config = GestureConfig()) : config_(config) {}
+
+    /**
+     * @brief Consumes one sample. Call for every controller report, including the
+     *        one with no fingers, which ends the gesture.
+     * @return The gesture this sample completed, or Gesture::None.
+     */
+    GestureResult feed(const TouchSample& sample);
+
+    void reset() { state_ = State::Idle; }
+
+private:
+    enum class State : uint8_t {
+        Idle,       // No finger down
+        Tracking,   // One finger: could still become a swipe, long press or two-finger drag
+        TwoFinger,  // Volume drag until all fingers lift
+        Done,       // Gesture already reported; wait for all fingers to lift
+    };
+
+    GestureConfig config_;
+    State    state_ = State::Idle;
+    uint32_t start_us_ = 0;
+    int16_t  start_x_ = 0, start_y_ = 0;
+    int16_t  last_x_ = 0, last_y_ = 0;
+    bool     moved_ = false;  // Left the slop radius at some point
+    int16_t  anchor_y_ = 0;   // Two-finger midpoint where the next step is measured from
+};
+
+#endif // GESTURES_H
@@ -1,6 +1,8 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 // #define DEBUG_MQTT // Uncomment to enable verbose MQTT debug output
+// #define DEBUG_BEATS // Uncomment to accept "beat_test [bpm]" on the command topic
+// #define DEBUG_UI_STYLES // Uncomment to log local vs shared style heap use and lookup time at boot
 
 #include <Arduino.h>
 #include <lvgl.h>
@@ -33,6 +35,7 @@ extern lv_obj_t *ui_position_label;
 extern lv_obj_t *ui_progress_bar;
 
 // --- Screen 2 UI Elements ---
+// nullptr while the Controls screen isn't built (see screens.h)
 extern lv_obj_t *ui_arc;
 extern lv_obj_t *ui_value_label;
 extern lv_obj_t *ui_mode_label;
@@ -41,19 +44,7 @@ extern lv_obj_t *ui_power_switch;
 extern lv_group_t *encoder_group;
 
 // --- Global State Variables ---
-extern int currentMode;
-extern const int totalModes;
-extern const char *modeNames[];
-
-extern long encoderValue;
-extern bool ledsOn;
-
-// For tracking hardware input state
-extern uint8_t lastPinA_State;
-extern uint8_t lastPinB_State;
-extern uint8_t lastEncSwitchState;
-extern uint8_t lastButton1State;
-extern uint8_t lastButton2State;
+// The LED value, power and mode live in app_state.h; the mode names in effects.h
 
 // For LVGL encoder driver
 extern long last_lvgl_encoder_val;
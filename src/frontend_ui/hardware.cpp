@@ -1,5 +1,39 @@
 #include "hardware.h"
+#include "i2c_bus.h"
+#include "inputs.h"
+#include "gestures.h"
+#include "buttons.h"
+#include "mqtt.h"
+#include "effects.h"
+#include "app_state.h"
 #include "ui.h"
+#include "screens.h"
+#include "lvgl_handler.h"
+
+static void step_mode(int direction) {
+    app_state_set_mode((app_state_mode() + direction + totalModes) % totalModes);
+}
+
+/**
+ * @brief Button actions for the mode logic.
+ */
+static void on_button_event(const ButtonEvent& event, void* ctx) {
+    switch (event.button) {
+        case BUTTON_ENCODER:
+            if (event.action == ButtonAction::Click) app_state_set_leds_on(!app_state_leds_on());
+            break;
+        case BUTTON_BACK:
+            if (event.action == ButtonAction::Click) screens_home();
+            if (event.action == ButtonAction::LongPress) screens_push(ScreenId::Controls);
+            break;
+        case BUTTON_MODE:
+            if (event.action == ButtonAction::Click || event.action == ButtonAction::Repeat) step_mode(-1);
+            if (event.action == ButtonAction::DoubleClick) step_mode(1);
+            break;
+        default:
+            break;
+    }
+}
 
 void hardware_init() {
     my_lcd.init();
@@ -8,6 +42,7 @@ void hardware_init() {
     my_lcd.setBacklightFreq(10000);
 
     Wire.begin(HW::I2C_SDA_PIN, HW::I2C_SCL_PIN);
+    Wire.setClock(HW::I2C_FREQ_HZ); // Fast mode: shorter expander reads mean fewer missed encoder states
     if (!TCA.begin()) {
         Serial.println("FATAL: TCA9535 not found.");
         while(1);
@@ -15,78 +50,96 @@ void hardware_init() {
     TCA.pinMode16(0xFFFF);
 
     FastLED.addLeds<LED_TYPE, HW::LED_DATA_PIN, COLOR_ORDER>(leds, HW::NUM_LEDS).setCorrection(TypicalLEDStrip);
-    FastLED.setBrightness(100);
+    // Brightness and dithering happen in the 16-bit pipeline (led_render.cpp)
+    FastLED.setBrightness(255);
+    FastLED.setDither(DISABLE_DITHER);
+
+    // Mode button: click = previous mode, double click = next, hold to keep cycling back
+    buttons_configure(BUTTON_MODE, {5000, 0, 300000, 600000, 400000});
+    buttons_subscribe(on_button_event, nullptr);
 
-    // Prime the input readers
-    uint16_t initialStates = TCA.read16();
-    lastPinA_State = (initialStates >> HW::ENCODER_A_PIN) & 1;
-    lastEncSwitchState = (initialStates >> HW::ENCODER_SW_PIN) & 1;
-    lastButton1State = (initialStates >> HW::BUTTON_1_PIN) & 1;
-    lastButton2State = (initialStates >> HW::BUTTON_2_PIN) & 1;
+    // From here on the bus owner task is the only user of Wire
+    i2c_bus_init();
+    inputs_init();
 }
 
-void handle_hardware_inputs() {
-    uint16_t pinStates = TCA.read16();
-    // --- Process Encoder Rotation ---
-    uint8_t pinA = (pinStates >> HW::ENCODER_A_PIN) & 1;
-    if (pinA == LOW && lastPinA_State == HIGH) {
-        uint8_t pinB = (pinStates >> HW::ENCODER_B_PIN) & 1;
-        if (pinB == HIGH) encoderValue++; else encoderValue--;
+/**
+ * @brief Screen changes, LED toggle and volume from touch gestures. Strokes that
+ *        start on a widget are the widget's: a fast seek on the progress bar is
+ *        not a swipe, and holding a button is not a long press.
+ */
+static void apply_gesture(Gesture gesture, int16_t value, int16_t start_x, int16_t start_y) {
+    if (lvgl_touch_owned_by_widget(start_x, start_y)) return;
+
+    switch (gesture) {
+        case Gesture::SwipeLeft:
+            if (screens_current() == ScreenId::Display) screens_push(ScreenId::Controls);
+            break;
+        case Gesture::SwipeRight:
+            if (screens_current() == ScreenId::Controls) screens_pop();
+            break;
+        case Gesture::LongPress:
+            lvgl_touch_cancel(); // The finger is still down; its release must not click
+            app_state_set_leds_on(!app_state_leds_on());
+            break;
+        case Gesture::VolumeDrag:
+            if (led_mode(app_state_mode()).controls_volume) {
+                // Volume mode: move the arc value, its observer publishes it
+                app_state_set_value(app_state_value() + value);
+            } else {
+                nudge_volume(value);
+            }
+            break;
+        default:
+            break;
     }
-    lastPinA_State = pinA;
+}
 
-    // --- Constrain value based on mode ---
-    int minVal = 0, maxVal = 100;
-    if (currentMode == 0) maxVal = 100;
-    if (currentMode == 1) maxVal = 255;
-    if (currentMode == 2) maxVal = HW::NUM_LEDS - 1;
-    if (currentMode == 3) maxVal = 100; // Volume 0-100%
-    encoderValue = constrain(encoderValue, minVal, maxVal);
+/**
+ * @brief Applies one input event to the mode state. Depends only on the event
+ *        and current state, so a recorded event stream replays identically.
+ */
+static void apply_input_event(const InputEvent& event) {
+    switch (event.type) {
+        case InputEventType::EncoderStep:
+            // Wide ranges get acceleration; picking one of a few LEDs stays one per click.
+            // The store clamps to the mode's range.
+            if (led_mode(app_state_mode()).max_value >= 100) {
+                app_state_set_value(app_state_value() + event.steps);
+            } else {
+                app_state_set_value(app_state_value() + event.delta);
+            }
+            break;
 
-    // --- Process Buttons ---
-    uint8_t encSwitchState = (pinStates >> HW::ENCODER_SW_PIN) & 1;
-    if (encSwitchState == LOW && lastEncSwitchState == HIGH) { ledsOn = !ledsOn; }
-    lastEncSwitchState = encSwitchState;
+        case InputEventType::ButtonDown:
+        case InputEventType::ButtonUp:
+            // Debounced and turned into clicks, holds and repeats by buttons.cpp
+            buttons_feed(event);
+            break;
 
-    // --- Back Button ---
-    uint8_t button1State = (pinStates >> HW::BUTTON_1_PIN) & 1;
-    if (button1State == LOW && lastButton1State == HIGH) {
-        lv_scr_load(ui_Screen1);
-    }
-    lastButton1State = button1State;
+        case InputEventType::Gesture:
+            apply_gesture((Gesture)event.id, event.delta, event.x, event.y);
+            break;
 
-    // --- Switch Button ---
-    uint8_t button2State = (pinStates >> HW::BUTTON_2_PIN) & 1;
-    if (button2State == LOW && lastButton2State == HIGH) {
-        currentMode = (currentMode - 1);
-        if (currentMode < 0) currentMode = totalModes - 1;
-        encoderValue = lv_arc_get_value(ui_arc);
+        default:
+            break;
     }
-    lastButton2State = button2State;
 }
 
-void update_leds() {
-    if (!ledsOn) {
-        FastLED.clear();
-        return;
+void handle_hardware_inputs() {
+    // Every edge since the last pass, in order; nothing between two loop() passes is lost
+    InputEvent event;
+    while (inputs_next_control_event(event)) {
+        apply_input_event(event);
     }
-    switch (currentMode) {
-        case 0:
-            FastLED.setBrightness(map(encoderValue, 0, 100, 0, 255));
-            fill_solid(leds, HW::NUM_LEDS, CRGB::Wheat);
-            break;
-        case 1:
-            FastLED.setBrightness(200);
-            fill_solid(leds, HW::NUM_LEDS, CHSV(encoderValue, 255, 255));
-            break;
-        case 2:
-            FastLED.setBrightness(200);
-            FastLED.clear();
-            leds[encoderValue] = CRGB::Red;
-            break;
-        case 3:
-            FastLED.setBrightness(0);
-            fill_solid(leds, HW::NUM_LEDS, CRGB::Blue);
-            break;
+    buttons_tick(micros());
+}
+
+uint16_t update_leds(const AppStateSnapshot& state, CRGB* frame) {
+    if (!state.leds_on) {
+        fill_solid(frame, HW::NUM_LEDS, CRGB::Black);
+        return 0;
     }
-}
\ No newline at end of file
+    led_mode_set_beat(beats_last_pulse());
+    return led_mode_render(state.mode, frame, HW::NUM_LEDS, millis(), state.value);
+}
@@ -3,9 +3,18 @@
 
 #include "globals.h"
 #include "config.h"
+#include "app_state.h"
 
 void hardware_init();
+
 void handle_hardware_inputs();
-void update_leds();
+
+/**
+ * @brief Renders the mode in a state snapshot into frame[]. Called by the LED render task.
+ * @param state Read once per frame with app_state_read(), so the frame is consistent.
+ * @param frame HW::NUM_LEDS colors to fill.
+ * @return Ring brightness, 0-65535.
+ */
+uint16_t update_leds(const AppStateSnapshot& state, CRGB* frame);
 
 #endif // HARDWARE_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+// src/frontend_ui/i2c_bus.cpp
+
+#include "i2c_bus.h"
+#include "config.h"
+#include <Wire.h>
+
+// --- Configuration ---
+constexpr uint32_t I2C_BUS_TASK_STACK = 3072;
+constexpr UBaseType_t I2C_BUS_TASK_PRIORITY = 6; // Above the input task that waits on it
+constexpr UBaseType_t I2C_QUEUE_DEPTH = 4;
+constexpr size_t DEVICE_COUNT = (size_t)I2cDevice::Count;
+
+static constexpr uint8_t DEVICE_ADDRESS[DEVICE_COUNT] = {
+    HW::TOUCH_I2C_ADDR,
+    HW::TCA_I2C_ADDR,
+};
+
+struct I2cRequest {
+    I2cDevice device;
+    uint8_t   reg;
+    uint8_t*  data;
+    uint8_t   length;
+    bool      write;
+    uint32_t  queued_us;
+    bool*     result;
+};
+
+/**
+ * @brief Per-device client side: callers of one device take turns, and the owner
+ *        signals completion on the device's own semaphore. Callers never use their
+ *        task notifications, which the input task reserves for its INT line.
+ */
+struct DeviceChannel {
+    SemaphoreHandle_t client;
+    SemaphoreHandle_t done;
+};
+
+// --- State Variables ---
+static TaskHandle_t bus_task_handle = nullptr;
+static QueueHandle_t high_queue = nullptr; // Touch: a late sample is visible lag
+static QueueHandle_t low_queue = nullptr;  // Expander: INT latches the change, a few hundred us don't matter
+static DeviceChannel channels[DEVICE_COUNT];
+static I2cDeviceStats device_stats[DEVICE_COUNT];
+
+// =========================================================================
+// OWNER TASK
+// =========================================================================
+
+static bool run_transaction(const I2cRequest& request) {
+    uint8_t address = DEVICE_ADDRESS[(size_t)request.device];
+    Wire.beginTransmission(address);
+    Wire.write(request.reg);
+
+    if (request.write) {
+        Wire.write(request.data, request.length);
+        return Wire.endTransmission() == 0;
+    }
+
+    // Register address, then a repeated start and one burst for all bytes
+    if (Wire.endTransmission(false) != 0) return false;
+    if (Wire.requestFrom(address, request.length) != request.length) return false;
+    return Wire.readBytes(request.data, request.length) == request.length;
+}
+
+static void i2c_bus_task(void* parameter) {
+    while (true) {
+        // High priority queue first, every time, so touch never waits behind a backlog
+        I2cRequest request;
+        if (xQueueReceive(high_queue, &request, 0) != pdTRUE &&
+            xQueueReceive(low_queue, &request, 0) != pdTRUE) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        bool ok = run_transaction(request);
+
+        I2cDeviceStats& stats = device_stats[(size_t)request.device];
+        stats.transactions++;
+        if (ok) {
+            stats.bytes += request.length;
+        } else {
+            stats.errors++;
+        }
+        stats.latency_us.record(micros() - request.queued_us);
+
+        *request.result = ok;
+        xSemaphoreGive(channels[(size_t)request.device].done);
+    }
+}
+
+/**
+ * @brief Hands a request to the owner task and waits for it to finish.
+ */
+static bool submit(I2cRequest& request) {
+    if (bus_task_handle == nullptr) return false;
+
+    DeviceChannel& channel = channels[(size_t)request.device];
+    bool result = false;
+    request.result = &result;
+
+    xSemaphoreTake(channel.client, portMAX_DELAY);
+    request.queued_us = micros();
+    QueueHandle_t queue = (request.device == I2cDevice::Touch) ? high_queue : low_queue;
+    xQueueSend(queue, &request, portMAX_DELAY);
+    xTaskNotifyGive(bus_task_handle);
+    xSemaphoreTake(channel.done, portMAX_DELAY);
+    xSemaphoreGive(channel.client);
+    return result;
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in i2c_bus.h)
+// =========================================================================
+
+void i2c_bus_init() {
+    high_queue = xQueueCreate(I2C_QUEUE_DEPTH, sizeof(I2cRequest));
+    low_queue = xQueueCreate(I2C_QUEUE_DEPTH, sizeof(I2cRequest));
+    for (DeviceChannel& channel : channels) {
+        channel.client = xSemaphoreCreateMutex();
+        channel.done = xSemaphoreCreateBinary();
+    }
+
+    xTaskCreatePinnedToCore(
+        i2c_bus_task, "I2CBus", I2C_BUS_TASK_STACK, NULL, I2C_BUS_TASK_PRIORITY, &bus_task_handle, 1
+    );
+}
+
+bool i2c_bus_read(I2cDevice device, uint8_t reg, uint8_t* data, uint8_t length) {
+    I2cRequest request = {device, reg, data, length, false, 0, nullptr};
+    return submit(request);
+}
+
+bool i2c_bus_write(I2cDevice device, uint8_t reg, const uint8_t* data, uint8_t length) {
+    I2cRequest request = {device, reg, const_cast<uint8_t*>(data), length, true, 0, nullptr};
+    return submit(request);
+}
+
+const I2cDeviceStats& i2c_bus_get_stats(I2cDevice device) {
+    return device_stats[(size_t)device];
+}
+
+void i2c_bus_reset_latency() {
+    for (I2cDeviceStats& stats : device_stats) {
+        stats.latency_us.reset();
+    }
+}
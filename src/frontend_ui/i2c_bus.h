@@ -0,0 +1,54 @@
+// src/frontend_ui/i2c_bus.h
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include "latency_histogram.h"
+
+// The devices on the shared bus (HW::I2C_SDA_PIN / HW::I2C_SCL_PIN)
+enum class I2cDevice : uint8_t {
+    Touch,    // FT6336 at HW::TOUCH_I2C_ADDR
+    Expander, // TCA9535 at HW::TCA_I2C_ADDR
+    Count
+};
+
+/**
+ * @brief Per-device bus counters.
+ */
+struct I2cDeviceStats {
+    uint32_t transactions;
+    uint32_t errors;              // NACKs, timeouts and short reads
+    uint32_t bytes;
+    LatencyHistogram latency_us;  // Queue wait plus transfer time
+};
+
+/**
+ * @brief Starts the bus owner task. From here on it is the only code that touches Wire;
+ *        everything else goes through i2c_bus_read() / i2c_bus_write().
+ *        Call after Wire.begin() and any library setup that uses Wire directly.
+ */
+void i2c_bus_init();
+
+/**
+ * @brief Reads consecutive registers in one transaction (register address, repeated start, burst read).
+ *        Blocks the caller until the owner task has run it. Touch requests are served
+ *        before any queued expander request.
+ * @return true if every byte arrived.
+ */
+bool i2c_bus_read(I2cDevice device, uint8_t reg, uint8_t* data, uint8_t length);
+
+/**
+ * @brief Writes consecutive registers in one transaction.
+ * @return true if the device acknowledged.
+ */
+bool i2c_bus_write(I2cDevice device, uint8_t reg, const uint8_t* data, uint8_t length);
+
+const I2cDeviceStats& i2c_bus_get_stats(I2cDevice device);
+
+/**
+ * @brief Starts a new latency window (counters keep running). Called after each telemetry report.
+ */
+void i2c_bus_reset_latency();
+
+#endif // I2C_BUS_H
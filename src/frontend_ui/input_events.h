@@ -0,0 +1,87 @@
+// src/frontend_ui/input_events.h
+
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// =========================================================================
+// INPUT EVENTS
+// Plain data with a timestamp, so a recorded stream replays identically.
+// =========================================================================
+
+enum class InputEventType : uint8_t {
+    EncoderStep, // delta = clicks, steps = accelerated steps
+    ButtonDown,  // id = InputButton
+    ButtonUp,    // id = InputButton
+    TouchDown,   // x, y = point
+    TouchMove,   // x, y = point
+    TouchUp,     // x, y = last point
+    Gesture,     // id = Gesture (gestures.h), delta = value, x, y = where the stroke started
+};
+
+enum InputButton : uint8_t {
+    BUTTON_ENCODER = 0, // Encoder push switch
+    BUTTON_BACK    = 1, // HW::BUTTON_1_PIN
+    BUTTON_MODE    = 2, // HW::BUTTON_2_PIN
+    BUTTON_COUNT
+};
+
+struct InputEvent {
+    uint32_t       time_us; // micros() when sampled
+    InputEventType type;
+    uint8_t        id;
+    int16_t        delta;
+    int16_t        steps;
+    int16_t        x;
+    int16_t        y;
+};
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring of input events.
+ *
+ * One task pushes, one task pops; neither ever blocks. When full, new events
+ * are dropped and counted rather than overwriting ones the consumer hasn't seen.
+ */
+template <size_t Capacity>
+class InputEventRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool push(const InputEvent& event) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= Capacity) {
+            dropped_++;
+            return false;
+        }
+        events_[head & (Capacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(InputEvent& event) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        event = events_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    uint32_t dropped() const { return dropped_; } // Producer side only
+
+private:
+    InputEvent events_[Capacity];
+    std::atomic<uint32_t> head_{0}; // Written by the producer
+    std::atomic<uint32_t> tail_{0}; // Written by the consumer
+    uint32_t dropped_ = 0;
+};
+
+#endif // INPUT_EVENTS_H
@@ -0,0 +1,284 @@
+// src/frontend_ui/inputs.cpp
+
+#include "inputs.h"
+#include "config.h"
+#include "i2c_bus.h"
+#include "gestures.h"
+#include <FT6336.h>
+
+// --- Configuration ---
+constexpr uint32_t INPUT_TASK_STACK = 3072;
+constexpr UBaseType_t INPUT_TASK_PRIORITY = 5; // Well above loop() and LVGL so edges are never read late
+constexpr uint32_t INPUT_FALLBACK_POLL_MS = 100; // Re-read even without an interrupt, in case an edge was missed
+constexpr uint32_t TOUCH_RESET_POLL_MS = 10;    // While the controller is coming out of reset
+constexpr uint32_t TOUCH_RELEASE_POLL_MS = 50;  // While touched: re-read if reports stop, so a lift is never missed
+constexpr uint8_t  EXPANDER_MAX_REREADS = 4;    // Re-reads while INT stays low; a stuck line falls back to polling
+
+// --- Task Notification Bits ---
+constexpr uint32_t NOTIFY_EXPANDER = 1 << 0;
+constexpr uint32_t NOTIFY_TOUCH    = 1 << 1;
+
+// --- Device Registers ---
+constexpr uint8_t TCA_REG_INPUT_PORT0 = 0x00; // Port 1 follows, so one 2-byte burst reads both
+
+// --- Event Queues (InputTask produces, the loop task consumes) ---
+static InputEventRing<32> control_events;    // Encoder, buttons and gestures, for the mode logic
+static InputEventRing<32> touch_events;      // Touch, for LVGL
+
+// --- State Variables ---
+static TaskHandle_t input_task_handle = nullptr;
+static InputStats stats = {};
+static uint16_t last_pins = 0xFFFF;  // Inputs idle high
+static bool touch_active = false;
+static int16_t touch_x = 0, touch_y = 0;
+static LatencyHistogram touch_latency_us; // INT edge to queued event
+static GestureRecognizer gestures;        // Sees every report, both points
+
+// The panel is portrait (320x480); the display runs in rotation 1 (landscape)
+static FT6336 touch(HW::I2C_SDA_PIN, HW::I2C_SCL_PIN, HW::TOUCH_INT_PIN, HW::TOUCH_RST_PIN,
+                    HW::screenHeight, HW::screenWidth);
+
+// Expander pin for each InputButton
+static constexpr uint8_t BUTTON_PINS[BUTTON_COUNT] = {
+    HW::ENCODER_SW_PIN, HW::BUTTON_1_PIN, HW::BUTTON_2_PIN,
+};
+
+// --- Quadrature Decoder (only touched by the input task) ---
+// Indexed by (previous AB << 2) | current AB. Valid Gray-code moves give +1/-1,
+// no change gives 0; the four entries where both phases flipped are invalid.
+static constexpr int8_t QUADRATURE_TABLE[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0,
+};
+static uint8_t last_ab = 0b11;        // Both phases idle high
+static int8_t quarter_steps = 0;      // Progress towards the next detent
+static uint32_t last_detent_us = 0;
+
+// =========================================================================
+// INTERRUPT & TASK
+// =========================================================================
+
+static void IRAM_ATTR notify_from_isr(uint32_t bits) {
+    if (input_task_handle == nullptr) return; // Before the task starts; its first pass reads the port anyway
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(input_task_handle, bits, eSetBits, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+static void IRAM_ATTR on_expander_interrupt() {
+    notify_from_isr(NOTIFY_EXPANDER);
+}
+
+static void IRAM_ATTR on_touch_interrupt(void* ctx) {
+    notify_from_isr(NOTIFY_TOUCH);
+}
+
+static bool touch_bus_read(uint8_t reg, uint8_t* buf, uint8_t size, void* ctx) {
+    return i2c_bus_read(I2cDevice::Touch, reg, buf, size);
+}
+
+static bool touch_bus_write(uint8_t reg, const uint8_t* buf, uint8_t size, void* ctx) {
+    return i2c_bus_write(I2cDevice::Touch, reg, buf, size);
+}
+
+template <size_t Capacity>
+static void emit(InputEventRing<Capacity>& ring, const InputEvent& event) {
+    if (!ring.push(event)) stats.events_dropped++;
+}
+
+static uint8_t encoder_ab(uint16_t pins) {
+    return (((pins >> HW::ENCODER_A_PIN) & 1) << 1) | ((pins >> HW::ENCODER_B_PIN) & 1);
+}
+
+/**
+ * @brief Steps per click for the time since the previous click: 1 when turning
+ *        slowly, rising linearly to HW::ENCODER_ACCEL_MAX for a fast flick.
+ */
+static int32_t acceleration_for(uint32_t interval_us) {
+    if (interval_us >= HW::ENCODER_ACCEL_WINDOW_US) return 1;
+    return 1 + (HW::ENCODER_ACCEL_MAX - 1) * (HW::ENCODER_ACCEL_WINDOW_US - interval_us) / HW::ENCODER_ACCEL_WINDOW_US;
+}
+
+/**
+ * @brief Advances the quadrature state machine and emits whole detents.
+ */
+static void decode_encoder(uint8_t ab, uint32_t now) {
+    uint8_t index = (last_ab << 2) | ab;
+    last_ab = ab;
+    if (index == 0b0011 || index == 0b0110 || index == 0b1001 || index == 0b1100) {
+        stats.encoder_invalid++;
+        return;
+    }
+
+    quarter_steps += QUADRATURE_TABLE[index];
+    if (quarter_steps >= HW::ENCODER_STEPS_PER_DETENT || quarter_steps <= -HW::ENCODER_STEPS_PER_DETENT) {
+        int16_t direction = quarter_steps > 0 ? 1 : -1;
+        quarter_steps = 0;
+
+        int16_t steps = acceleration_for(now - last_detent_us);
+        last_detent_us = now;
+
+        emit(control_events, {now, InputEventType::EncoderStep, 0, direction, (int16_t)(direction * steps), 0, 0});
+        stats.encoder_detents++;
+    }
+}
+
+/**
+ * @brief Emits down/up events for every button whose pin changed.
+ */
+static void detect_buttons(uint16_t pins, uint32_t now) {
+    uint16_t changed = pins ^ last_pins;
+    for (uint8_t id = 0; id < BUTTON_COUNT; id++) {
+        if (!((changed >> BUTTON_PINS[id]) & 1)) continue;
+
+        bool pressed = ((pins >> BUTTON_PINS[id]) & 1) == LOW;
+        InputEvent event = {now, pressed ? InputEventType::ButtonDown : InputEventType::ButtonUp, id, 0, 0, 0, 0};
+        emit(control_events, event);
+    }
+}
+
+static bool read_port(uint16_t& pins) {
+    uint8_t ports[2];
+    if (!i2c_bus_read(I2cDevice::Expander, TCA_REG_INPUT_PORT0, ports, sizeof(ports))) return false;
+    pins = ports[0] | (ports[1] << 8);
+    return true;
+}
+
+/**
+ * @brief Reads the port once and turns the changes into events.
+ * @return false if the read failed.
+ */
+static bool sample_port() {
+    uint16_t pins;
+    if (!read_port(pins)) return false; // Counted by the bus; the next INT or poll retries
+    uint32_t now = micros();
+    stats.port_reads++;
+
+    decode_encoder(encoder_ab(pins), now);
+    detect_buttons(pins, now);
+    last_pins = pins;
+    return true;
+}
+
+/**
+ * @brief Reads status and both points in one burst and emits down, move and up events.
+ *        Samples that didn't move are not queued.
+ */
+static void sample_touch(bool triggered) {
+    if (!touch.read()) return;
+    uint32_t now = micros();
+    stats.touch_reads++;
+    stats.touch_interrupts = touch.stats.interrupts;
+    if (triggered) touch_latency_us.record(touch.stats.latencyUs);
+
+    TouchSample sample = {now, touch.isTouched ? touch.touches : (uint8_t)0, {0, 0}, {0, 0}};
+    for (uint8_t i = 0; i < sample.count; i++) {
+        sample.x[i] = touch.points[i].x;
+        sample.y[i] = touch.points[i].y;
+    }
+    GestureResult gesture = gestures.feed(sample);
+    if (gesture.gesture != Gesture::None) {
+        emit(control_events, {now, InputEventType::Gesture, (uint8_t)gesture.gesture, gesture.value, 0,
+                              gesture.start_x, gesture.start_y});
+    }
+
+    // LVGL gets the first point only
+    if (touch.isTouched) {
+        int16_t x = touch.points[0].x;
+        int16_t y = touch.points[0].y;
+        if (touch_active && x == touch_x && y == touch_y) return;
+        InputEventType type = touch_active ? InputEventType::TouchMove : InputEventType::TouchDown;
+        touch_active = true;
+        touch_x = x;
+        touch_y = y;
+        emit(touch_events, {now, type, 0, 0, 0, touch_x, touch_y});
+    } else if (touch_active) {
+        touch_active = false;
+        emit(touch_events, {now, InputEventType::TouchUp, 0, 0, 0, touch_x, touch_y});
+    }
+}
+
+static void input_task(void* parameter) {
+    uint32_t last_port_read = millis() - INPUT_FALLBACK_POLL_MS; // Catch edges from before the task ran
+    uint32_t last_touch_read = millis();
+    while (true) {
+        // Both devices wake the task through their INT lines; the timeouts are safety nets
+        uint32_t wait_ms = INPUT_FALLBACK_POLL_MS;
+        if (touch.state() == FT6336::RESET_LOW || touch.state() == FT6336::STARTING_UP) {
+            wait_ms = TOUCH_RESET_POLL_MS;
+        } else if (touch_active) {
+            wait_ms = TOUCH_RELEASE_POLL_MS;
+        }
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(wait_ms));
+
+        if ((bits & NOTIFY_EXPANDER) || millis() - last_port_read >= INPUT_FALLBACK_POLL_MS) {
+            if (bits & NOTIFY_EXPANDER) stats.interrupts++;
+            last_port_read = millis();
+
+            // Reading the port clears INT. If it is still low, pins changed again
+            // while we were reading and no new falling edge will arrive. A line
+            // that stays low (or a bus that keeps failing) is left to the
+            // fallback poll instead of holding the core at this priority.
+            uint8_t rereads = 0;
+            while (sample_port() && digitalRead(HW::TCA_INT_PIN) == LOW) {
+                if (++rereads > EXPANDER_MAX_REREADS) {
+                    stats.int_stuck++;
+                    break;
+                }
+            }
+        }
+
+        if (!touch.update()) continue; // Still resetting (or absent)
+        bool triggered = (bits & NOTIFY_TOUCH) != 0;
+        if (triggered || (touch_active && millis() - last_touch_read >= TOUCH_RELEASE_POLL_MS)) {
+            last_touch_read = millis();
+            sample_touch(triggered);
+        }
+    }
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in inputs.h)
+// =========================================================================
+
+void inputs_init() {
+    // Prime the decoder and button states so the first read doesn't look like an edge
+    read_port(last_pins);
+    last_ab = encoder_ab(last_pins);
+
+    // The TCA9535 INT output is open-drain and active low
+    pinMode(HW::TCA_INT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(HW::TCA_INT_PIN), on_expander_interrupt, FALLING);
+
+    // Starts the reset pulse and returns; the input task finishes bring-up without blocking setup()
+    touch.setTransport(touch_bus_read, touch_bus_write, nullptr);
+    touch.onInterrupt(on_touch_interrupt, nullptr);
+    touch.setRotation(ROTATION_RIGHT);
+    touch.begin();
+
+    // Last, so the task never sees a half-configured touch driver
+    xTaskCreatePinnedToCore(
+        input_task, "InputTask", INPUT_TASK_STACK, NULL, INPUT_TASK_PRIORITY, &input_task_handle, 1
+    );
+}
+
+bool inputs_next_control_event(InputEvent& event) {
+    return control_events.pop(event);
+}
+
+bool inputs_next_touch_event(InputEvent& event, bool& more) {
+    bool popped = touch_events.pop(event);
+    more = !touch_events.empty();
+    return popped;
+}
+
+const InputStats& inputs_get_stats() {
+    return stats;
+}
+
+LatencyHistogram& inputs_touch_latency() {
+    return touch_latency_us;
+}
@@ -0,0 +1,52 @@
+// src/frontend_ui/inputs.h
+
+#ifndef INPUTS_H
+#define INPUTS_H
+
+#include <Arduino.h>
+#include "input_events.h"
+#include "latency_histogram.h"
+
+/**
+ * @brief Input sampling counters.
+ */
+struct InputStats {
+    uint32_t interrupts;       // Falling edges on the TCA9535 INT line
+    uint32_t int_stuck;        // Times INT stayed low through every re-read
+    uint32_t port_reads;       // I2C reads of the input port
+    uint32_t touch_interrupts; // Reports signalled on the FT6336 INT line
+    uint32_t touch_reads;      // Burst reads of the touch controller
+    uint32_t encoder_detents;  // Clicks decoded
+    uint32_t encoder_invalid;  // Transitions where both phases changed, i.e. a state was missed
+    uint32_t events_dropped;   // Events lost because a consumer fell behind
+};
+
+/**
+ * @brief Starts the input task. It reads the TCA9535 and the FT6336 only when
+ *        their INT lines signal a change, and turns every change into a
+ *        timestamped InputEvent queued for the consumers below.
+ *        Call after the expander has been initialized.
+ */
+void inputs_init();
+
+/**
+ * @brief Next encoder, button or gesture event for the mode logic, oldest first.
+ * @return false once the queue is empty.
+ */
+bool inputs_next_control_event(InputEvent& event);
+
+/**
+ * @brief Next touch event for the LVGL pointer driver.
+ * @param more Set to whether further events are already waiting.
+ */
+bool inputs_next_touch_event(InputEvent& event, bool& more);
+
+const InputStats& inputs_get_stats();
+
+/**
+ * @brief Time from the touch controller's INT edge to the event being queued.
+ *        Telemetry reads and resets it.
+ */
+LatencyHistogram& inputs_touch_latency();
+
+#endif // INPUTS_H
@@ -0,0 +1,100 @@
+// src/frontend_ui/json_arena.h
+
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/**
+ * @brief Fixed-size bump allocator for ArduinoJson documents.
+ *
+ * The arena lives in static memory and is reset before each message, so
+ * parsing never touches the heap. Freeing or growing the most recent block
+ * happens in place (this is what ArduinoJson's string builder does while
+ * parsing); anything else is simply reclaimed by the next reset().
+ *
+ * Usage:
+ *     arena.reset();
+ *     JsonDocument doc(&arena);
+ *     deserializeJson(doc, payload, length, DeserializationOption::Filter(filter));
+ */
+template <size_t Capacity>
+class JsonArena : public ArduinoJson::Allocator {
+public:
+    void* allocate(size_t size) override {
+        const size_t needed = HEADER_SIZE + align(size);
+        if (needed > Capacity - top_) {
+            failures_++;
+            return nullptr; // ArduinoJson reports this as NoMemory
+        }
+        uint8_t* block = buffer_ + top_;
+        *reinterpret_cast<size_t*>(block) = size;
+        last_ = top_;
+        top_ += needed;
+        if (top_ > high_water_) high_water_ = top_;
+        return block + HEADER_SIZE;
+    }
+
+    void deallocate(void* ptr) override {
+        // Only the most recent block can be given back before the next reset
+        if (ptr && offset_of(ptr) == last_) {
+            top_ = last_;
+        }
+    }
+
+    void* reallocate(void* ptr, size_t new_size) override {
+        if (ptr == nullptr) return allocate(new_size);
+
+        const size_t offset = offset_of(ptr);
+        size_t& old_size = *reinterpret_cast<size_t*>(buffer_ + offset);
+        if (offset == last_) {
+            // Grow or shrink the last block in place
+            const size_t needed = HEADER_SIZE + align(new_size);
+            if (needed > Capacity - offset) {
+                failures_++;
+                return nullptr;
+            }
+            old_size = new_size;
+            top_ = offset + needed;
+            if (top_ > high_water_) high_water_ = top_;
+            return ptr;
+        }
+
+        void* moved = allocate(new_size);
+        if (moved) memcpy(moved, ptr, min(old_size, new_size));
+        return moved;
+    }
+
+    /**
+     * @brief Releases every block at once. Call before building the next document.
+     */
+    void reset() {
+        top_ = 0;
+        last_ = SIZE_MAX;
+    }
+
+    size_t capacity() const { return Capacity; }
+    size_t high_water() const { return high_water_; }  // Most bytes ever in use
+    uint32_t failures() const { return failures_; }    // Allocations refused for lack of space
+
+private:
+    static constexpr size_t ALIGNMENT = 8;
+    static constexpr size_t HEADER_SIZE = ALIGNMENT; // Holds the block size, keeps payload aligned
+
+    static constexpr size_t align(size_t size) {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    size_t offset_of(void* ptr) const {
+        return static_cast<uint8_t*>(ptr) - HEADER_SIZE - buffer_;
+    }
+
+    alignas(ALIGNMENT) uint8_t buffer_[Capacity];
+    size_t top_ = 0;
+    size_t last_ = SIZE_MAX;
+    size_t high_water_ = 0;
+    uint32_t failures_ = 0;
+};
+
+#endif // JSON_ARENA_H
@@ -0,0 +1,77 @@
+// src/frontend_ui/latency_histogram.h
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Fixed-size histogram for timing percentiles.
+ *
+ * Values 0-7 get exact buckets; above that each power of two is split into
+ * four buckets, so a reported percentile is at most 25% above the true value.
+ * Recording is a count-leading-zeros and an increment. Values from 2^17 up
+ * share the last bucket; max() stays exact.
+ */
+class LatencyHistogram {
+public:
+    void record(uint32_t value) {
+        counts_[bucket_index(value)]++;
+        count_++;
+        if (value > max_) max_ = value;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the given percentile, 0 if empty.
+     * @param pct Percentile, 0-100.
+     */
+    uint32_t percentile(uint8_t pct) const {
+        if (count_ == 0) return 0;
+        uint32_t rank = ((uint64_t)count_ * pct + 99) / 100;
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                uint32_t upper = bucket_upper(i);
+                return (i == BUCKETS - 1 || upper > max_) ? max_ : upper;
+            }
+        }
+        return max_;
+    }
+
+    uint32_t count() const { return count_; }
+    uint32_t max() const { return max_; }
+
+    void reset() {
+        for (uint32_t& c : counts_) c = 0;
+        count_ = 0;
+        max_ = 0;
+    }
+
+private:
+    static constexpr size_t EXACT = 8;
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t BUCKETS = EXACT + 14 * SUB_BUCKETS; // Up to 2^17
+
+    static size_t bucket_index(uint32_t value) {
+        if (value < EXACT) return value;
+        uint32_t msb = 31 - __builtin_clz(value);
+        size_t index = EXACT + (msb - 3) * SUB_BUCKETS + ((value >> (msb - 2)) & (SUB_BUCKETS - 1));
+        return index < BUCKETS ? index : BUCKETS - 1;
+    }
+
+    static uint32_t bucket_upper(size_t index) {
+        if (index < EXACT) return index;
+        uint32_t msb = 3 + (index - EXACT) / SUB_BUCKETS;
+        uint32_t sub = (index - EXACT) % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (msb - 2)) - 1;
+    }
+
+    uint32_t counts_[BUCKETS] = {};
+    uint32_t count_ = 0;
+    uint32_t max_ = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_H
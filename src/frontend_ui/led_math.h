@@ -0,0 +1,89 @@
+// src/frontend_ui/led_math.h
+
+#ifndef LED_MATH_H
+#define LED_MATH_H
+
+#include <stdint.h>
+#include <array>
+
+// =========================================================================
+// FIXED-POINT HELPERS FOR LED EFFECTS
+// Angles are 0-255 for a full turn; levels are 0-255. The tables are built
+// by the compiler, so they cost flash but no start-up time or RAM.
+//
+// The names stay clear of FastLED's: it defines sin8 as a macro and scale8
+// at global scope, which would swap or shadow same-named helpers here. Call
+// them qualified, e.g. led_math::sine_u8().
+// =========================================================================
+
+namespace led_math {
+
+constexpr double LED_PI = 3.14159265358979323846; // PI itself is a macro in Arduino.h
+
+/**
+ * @brief sin(x) for |x| <= pi/2 by Taylor series; accurate to well under one LSB of 8 bits.
+ */
+constexpr double taylor_sin(double x) {
+    double term = x, sum = x;
+    for (int n = 1; n < 8; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double const_sin(double x) {
+    // Fold into [-pi/2, pi/2] using sin(pi - x) = sin(x)
+    while (x > LED_PI) x -= 2 * LED_PI;
+    while (x < -LED_PI) x += 2 * LED_PI;
+    if (x > LED_PI / 2) x = LED_PI - x;
+    if (x < -LED_PI / 2) x = -LED_PI - x;
+    return taylor_sin(x);
+}
+
+constexpr double const_sqrt(double x) {
+    if (x <= 0) return 0;
+    double guess = x > 1 ? x : 1;
+    for (int i = 0; i < 32; i++) guess = (guess + x / guess) / 2;
+    return guess;
+}
+
+constexpr std::array<uint8_t, 256> make_sine_table() {
+    std::array<uint8_t, 256> table{};
+    for (int i = 0; i < 256; i++) {
+        table[i] = (uint8_t)(128.0 + 127.5 * const_sin(2 * LED_PI * i / 256));
+    }
+    return table;
+}
+
+/**
+ * @brief Perceptual correction with gamma 2.5 (x^2 * sqrt(x)), a good match for WS2812s.
+ */
+constexpr std::array<uint8_t, 256> make_gamma_table() {
+    std::array<uint8_t, 256> table{};
+    for (int i = 0; i < 256; i++) {
+        double x = i / 255.0;
+        table[i] = (uint8_t)(255.0 * x * x * const_sqrt(x) + 0.5);
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> SINE = make_sine_table();
+constexpr std::array<uint8_t, 256> GAMMA = make_gamma_table();
+
+static_assert(SINE[0] == 128 && SINE[64] == 255 && SINE[192] == 0, "sine table");
+static_assert(GAMMA[0] == 0 && GAMMA[255] == 255, "gamma table");
+
+/**
+ * @brief Sine of an 8-bit angle, 0-255 centred on 128.
+ */
+inline uint8_t sine_u8(uint8_t angle) { return SINE[angle]; }
+
+/**
+ * @brief Linear level to perceived level.
+ */
+inline uint8_t gamma_u8(uint8_t level) { return GAMMA[level]; }
+
+} // namespace led_math
+
+#endif // LED_MATH_H
@@ -0,0 +1,236 @@
+// src/frontend_ui/led_render.cpp
+
+#include "led_render.h"
+#include "globals.h"
+#include "hardware.h"
+#include "beats.h"
+#include "effects.h"
+#include <esp_timer.h>
+#include <atomic>
+
+// --- Configuration ---
+constexpr uint32_t LED_TASK_STACK = 3072;
+constexpr UBaseType_t LED_TASK_PRIORITY = 2; // Just above loop(), below input handling
+constexpr TickType_t LED_FRAME_TICKS = pdMS_TO_TICKS(1000 / HW::LED_FPS);
+
+// --- State Variables ---
+// 16-bit linear channel levels, in CRGB order. The strip only gets 8 bits;
+// the rest is carried between frames by the dither.
+struct Frame16 {
+    uint16_t c[HW::NUM_LEDS][3];
+};
+
+static CRGB target[HW::NUM_LEDS];      // The effect's frame, before brightness
+static uint16_t target_brightness = 0;
+static uint32_t target_version = 0;    // State version target was rendered from
+static bool target_valid = false;
+static Frame16 output;                 // What the pipeline last produced
+static Frame16 previous_output;        // output one frame earlier, to tell when the ring settles
+static Frame16 fade_from;              // output when the running crossfade started
+static uint8_t dither_error[HW::NUM_LEDS][3];
+static uint32_t fade_start_us = 0;
+static uint32_t fade_us = 0;           // 0: no crossfade running
+static std::atomic<uint32_t> fade_request_ms{0}; // Set by any task, taken by the LED task
+static int faded_mode = -1;            // Mode and power the last fade went to, to spot
+static bool faded_leds_on = false;     // changes in the state snapshot
+
+static CRGB shown_frame[HW::NUM_LEDS]; // What the strip currently displays
+static bool frame_valid = false;
+static LedRenderStats stats = {};
+
+static TaskHandle_t led_task = nullptr;
+static esp_timer_handle_t beat_timer = nullptr; // Wakes the task for a beat between frames
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+/**
+ * @brief Crossfade weight for this frame, 0-65536, eased at both ends.
+ *        One division per frame; the per-LED work below is multiply and shift only.
+ */
+static uint32_t crossfade_weight(uint32_t now_us) {
+    uint32_t request = fade_request_ms.exchange(0);
+    if (request) {
+        fade_from = output; // From wherever the ring is, even mid-fade
+        fade_start_us = now_us;
+        fade_us = request * 1000;
+    }
+    if (fade_us == 0) return 65536;
+
+    uint32_t elapsed = now_us - fade_start_us;
+    if (elapsed >= fade_us) {
+        fade_us = 0;
+        return 65536;
+    }
+    uint64_t t = ((uint64_t)elapsed << 16) / fade_us;
+    return (t * t * ((3 << 16) - 2 * t)) >> 32; // Smoothstep
+}
+
+/**
+ * @brief Target x brightness at 16 bits, blended from fade_from, into output.
+ */
+static void run_pipeline(uint16_t brightness) {
+    uint32_t weight = crossfade_weight(micros());
+    for (int i = 0; i < HW::NUM_LEDS; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            // 8-bit channel to 16 bits (x257), scaled by the 16-bit brightness
+            uint32_t level = ((uint32_t)target[i][ch] * 257 * brightness) >> 16;
+            if (weight < 65536) {
+                int32_t from = fade_from.c[i][ch];
+                level = from + (((int64_t)((int32_t)level - from) * weight) >> 16);
+            }
+            output.c[i][ch] = level;
+        }
+    }
+}
+
+/**
+ * @brief output to leds[] with a temporal dither: the low byte accumulates
+ *        until it carries into the output. Only while the levels are moving.
+ */
+static void dither_output() {
+    for (int i = 0; i < HW::NUM_LEDS; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            uint32_t sum = output.c[i][ch] + dither_error[i][ch];
+            dither_error[i][ch] = sum & 0xFF;
+            leds[i][ch] = sum > 0xFFFF ? 255 : sum >> 8;
+        }
+    }
+}
+
+/**
+ * @brief output to leds[], rounded. Used once the levels hold still, so a
+ *        settled ring gives the same 8-bit frame every time and is skipped.
+ */
+static void round_output() {
+    for (int i = 0; i < HW::NUM_LEDS; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            uint32_t level = output.c[i][ch] + 0x80;
+            leds[i][ch] = level > 0xFFFF ? 255 : level >> 8;
+        }
+    }
+    memset(dither_error, 0, sizeof(dither_error));
+}
+
+/**
+ * @brief Whether the freshly rendered frame differs from the one showing.
+ */
+static bool frame_changed() {
+    return !frame_valid || memcmp(leds, shown_frame, sizeof(shown_frame)) != 0;
+}
+
+static void render_frame() {
+    uint32_t start = micros();
+    AppStateSnapshot state;
+    app_state_read(state);
+
+    // Mode changes and on/off fade instead of snapping. Spotted here rather than
+    // requested by an app_state observer, so the fade always starts on the frame
+    // that first renders the new state, from the frame before it.
+    if (state.mode != faded_mode || state.leds_on != faded_leds_on) {
+        if (faded_mode >= 0) led_render_crossfade(HW::LED_CROSSFADE_MS);
+        faded_mode = state.mode;
+        faded_leds_on = state.leds_on;
+    }
+
+    // A static mode only needs rendering again when the state changed; the
+    // pipeline still runs for crossfades and dithering
+    bool animated = state.leds_on && led_mode(state.mode).animated;
+    if (animated || !target_valid || state.version != target_version) {
+        target_brightness = update_leds(state, target);
+        target_version = state.version;
+        target_valid = true;
+        uint32_t effect_us = micros() - start;
+        if (effect_us > stats.effect_us_max) stats.effect_us_max = effect_us;
+        if (effect_us > HW::LED_EFFECT_BUDGET_US) stats.effect_over_budget++;
+    } else {
+        stats.effects_reused++;
+    }
+
+    run_pipeline(target_brightness);
+    // Dithering a still frame would flip the low bits every frame and defeat
+    // the skip below, so it only runs while a fade or an animation moves
+    bool settled = frame_valid && memcmp(&output, &previous_output, sizeof(output)) == 0;
+    previous_output = output;
+    if (settled) {
+        round_output();
+    } else {
+        dither_output();
+    }
+    uint32_t frame_us = micros() - start;
+    if (frame_us > stats.frame_us_max) stats.frame_us_max = frame_us;
+    if (frame_us > HW::LED_FRAME_BUDGET_US) stats.frame_over_budget++;
+
+    if (!frame_changed()) {
+        stats.frames_skipped++;
+        return;
+    }
+
+    // The RMT peripheral clocks the bits out; this task only waits for it
+    FastLED.show();
+    memcpy(shown_frame, leds, sizeof(shown_frame));
+    frame_valid = true;
+    stats.frames_shown++;
+
+    uint32_t elapsed = micros() - start;
+    if (elapsed > stats.render_us_max) stats.render_us_max = elapsed;
+}
+
+static void beat_timer_cb(void* arg) {
+    xTaskNotifyGive(led_task);
+}
+
+/**
+ * @brief Blocks until a one-shot esp_timer fires, so a beat lands within the
+ *        timer's resolution instead of a whole RTOS tick, without spinning.
+ */
+static void wait_us(uint32_t us) {
+    ulTaskNotifyTake(pdTRUE, 0); // Drop a wake-up left over from a timed-out wait
+    if (esp_timer_start_once(beat_timer, us) != ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(us / 1000) + 1);
+        return;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(us / 1000) + 2); // Timeout only as a safety net
+    esp_timer_stop(beat_timer);
+}
+
+static void led_render_task(void* parameter) {
+    led_task = xTaskGetCurrentTaskHandle();
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        // A beat due before the next frame gets a frame of its own, so beats
+        // aren't quantized to the frame rate. The frame schedule is unaffected.
+        uint32_t beat_in_us = beats_poll();
+        TickType_t frame_in_ticks = last_wake + LED_FRAME_TICKS - xTaskGetTickCount();
+        if ((int32_t)frame_in_ticks > 0 && beat_in_us < frame_in_ticks * portTICK_PERIOD_MS * 1000) {
+            wait_us(beat_in_us);
+        } else {
+            vTaskDelayUntil(&last_wake, LED_FRAME_TICKS);
+        }
+        beats_poll();
+        render_frame();
+    }
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in led_render.h)
+// =========================================================================
+
+void led_render_init() {
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = beat_timer_cb;
+    timer_args.name = "LedBeat";
+    esp_timer_create(&timer_args, &beat_timer);
+    xTaskCreatePinnedToCore(
+        led_render_task, "LedRender", LED_TASK_STACK, NULL, LED_TASK_PRIORITY, NULL, 1
+    );
+}
+
+void led_render_crossfade(uint32_t duration_ms) {
+    fade_request_ms.store(duration_ms > 0 ? duration_ms : 1);
+}
+
+const LedRenderStats& led_render_get_stats() {
+    return stats;
+}
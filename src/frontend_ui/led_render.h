@@ -0,0 +1,44 @@
+// src/frontend_ui/led_render.h
+
+#ifndef LED_RENDER_H
+#define LED_RENDER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief LED output counters.
+ */
+struct LedRenderStats {
+    uint32_t frames_shown;    // Frames sent to the strip
+    uint32_t frames_skipped;  // Frames identical to the one already showing
+    uint32_t effects_reused;  // Frames of a static mode with an unchanged state version, not re-rendered
+    uint32_t effect_us_max;   // Longest update_leds(), i.e. effect rendering alone
+    uint32_t effect_over_budget; // Frames whose rendering took longer than HW::LED_EFFECT_BUDGET_US
+    uint32_t frame_us_max;    // Longest effect + crossfade + dither
+    uint32_t frame_over_budget;  // Frames over HW::LED_FRAME_BUDGET_US before show()
+    uint32_t render_us_max;   // Longest update_leds() + pipeline + show()
+};
+
+/**
+ * @brief Starts the LED render task. It calls update_leds() at HW::LED_FPS, applies
+ *        the brightness and any crossfade at 16 bits per channel, dithers down to
+ *        8 bits over time while the levels move, rounds them once they settle,
+ *        and only sends the frame to the strip when it differs from the last one.
+ *        A scheduled beat (see beats.h) that falls between frames gets an extra
+ *        frame at its due time.
+ *        Mode and on/off changes in the app state snapshot crossfade by
+ *        themselves over HW::LED_CROSSFADE_MS.
+ *        Call after hardware_init(); loop() no longer touches FastLED.
+ */
+void led_render_init();
+
+/**
+ * @brief Fades from whatever the ring shows now to the live frame. A new call
+ *        restarts the fade from the current mid-fade state. Safe from any task.
+ * @param duration_ms Fade time.
+ */
+void led_render_crossfade(uint32_t duration_ms);
+
+const LedRenderStats& led_render_get_stats();
+
+#endif // LED_RENDER_H
@@ -1,4 +1,61 @@
 #include "lvgl_handler.h"
+#include "hardware.h"
+#include "inputs.h"
+#include "touch_filter.h"
+#include "buttons.h"
+#include "app_state.h"
+
+// --- Touch Filtering ---
+constexpr size_t MAX_TOUCH_PROFILES = 8;
+
+struct TouchProfileEntry {
+    lv_obj_t* obj;
+    const TouchFilterProfile* profile;
+};
+
+static TouchProfileEntry touch_profiles[MAX_TOUCH_PROFILES] = {};
+
+// Debounced encoder switch edges, queued so a short click between two reads still reaches LVGL
+static InputEventRing<8> encoder_key_events;
+static TouchFilter touch_filter;
+
+static LvglStats stats = {};
+static lv_indev_t* touch_indev = nullptr;
+
+/**
+ * @brief Scrollable with content beyond its edges. The flag alone says little:
+ *        LVGL sets it on most widgets by default.
+ */
+static bool can_scroll(lv_obj_t* obj) {
+    return lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLLABLE) &&
+           (lv_obj_get_scroll_top(obj) > 0 || lv_obj_get_scroll_bottom(obj) > 0 ||
+            lv_obj_get_scroll_left(obj) > 0 || lv_obj_get_scroll_right(obj) > 0);
+}
+
+/**
+ * @brief Whether obj, or a parent below the screen, reacts to being pressed or dragged.
+ */
+static bool is_interactive(lv_obj_t* obj) {
+    lv_obj_t* screen = lv_screen_active();
+    for (; obj != nullptr && obj != screen; obj = lv_obj_get_parent(obj)) {
+        if (lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE) || can_scroll(obj)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief The profile of the widget (or its nearest registered parent) under the point.
+ */
+static const TouchFilterProfile& profile_at(int16_t x, int16_t y) {
+    lv_point_t point = {x, y};
+    lv_obj_t* obj = lv_indev_search_obj(lv_screen_active(), &point);
+    for (; obj != nullptr; obj = lv_obj_get_parent(obj)) {
+        for (const TouchProfileEntry& entry : touch_profiles) {
+            if (entry.obj == obj) return *entry.profile;
+        }
+    }
+    return TOUCH_PROFILE_DEFAULT;
+}
 
 // LVGL Driver Callbacks
 void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
@@ -8,18 +65,83 @@ void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
     lv_display_flush_ready(disp);
 }
 void my_touchpad_read(lv_indev_t *indev, lv_indev_data_t *data) {
-    uint16_t touchX, touchY;
-    bool touched = my_lcd.getTouch(&touchX, &touchY);
-    data->state = touched ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
-    if (touched) { data->point.x = touchX; data->point.y = touchY; }
+    // One queued event per read; continue_reading makes LVGL come back for the rest
+    static InputEvent last_touch = {0, InputEventType::TouchUp, 0, 0, 0, 0, 0};
+    bool more = false;
+    if (inputs_next_touch_event(last_touch, more)) {
+        if (last_touch.type == InputEventType::TouchDown) {
+            // The widget under the first contact decides the tuning for the whole stroke
+            touch_filter.set_profile(profile_at(last_touch.x, last_touch.y));
+            touch_filter.begin(last_touch.x, last_touch.y, last_touch.time_us);
+        } else {
+            touch_filter.update(last_touch.x, last_touch.y, last_touch.time_us);
+        }
+    }
+
+    int16_t x, y;
+    if (last_touch.type == InputEventType::TouchUp || more) {
+        // Release where the finger settled; intermediate samples need no prediction
+        touch_filter.filtered(x, y);
+    } else {
+        touch_filter.predicted(x, y);
+    }
+    data->state = last_touch.type == InputEventType::TouchUp ? LV_INDEV_STATE_RELEASED : LV_INDEV_STATE_PRESSED;
+    data->point.x = constrain(x, 0, (int16_t)(HW::screenWidth - 1));
+    data->point.y = constrain(y, 0, (int16_t)(HW::screenHeight - 1));
+    data->continue_reading = more;
 }
 void my_encoder_read(lv_indev_t *indev, lv_indev_data_t *data) {
-    data->enc_diff = encoderValue - last_lvgl_encoder_val;
-    last_lvgl_encoder_val = encoderValue;
-    data->state = (TCA.read1(HW::ENCODER_SW_PIN) == LOW) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    int32_t value = app_state_value();
+    data->enc_diff = value - last_lvgl_encoder_val;
+    last_lvgl_encoder_val = value;
+    static bool pressed = false;
+    InputEvent event;
+    if (encoder_key_events.pop(event)) {
+        pressed = (event.type == InputEventType::ButtonDown);
+    }
+    data->state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = !encoder_key_events.empty();
 }
 uint32_t my_tick_get_cb(void) { return millis(); }
 
+static void on_button_event(const ButtonEvent& event, void* ctx) {
+    if (event.button != BUTTON_ENCODER) return;
+    if (event.action == ButtonAction::Press || event.action == ButtonAction::Release) {
+        InputEventType type = (event.action == ButtonAction::Press) ? InputEventType::ButtonDown : InputEventType::ButtonUp;
+        encoder_key_events.push({event.time_us, type, BUTTON_ENCODER, 0, 0, 0, 0});
+    }
+}
+
+static void forget_touch_profile(lv_event_t* e) {
+    lv_obj_t* obj = (lv_obj_t*)lv_event_get_target(e);
+    for (TouchProfileEntry& entry : touch_profiles) {
+        if (entry.obj == obj) entry.obj = nullptr;
+    }
+}
+
+static void count_invalidation(lv_event_t* e) {
+    stats.invalidations++;
+}
+
+static void count_render(lv_event_t* e) {
+    stats.renders++;
+}
+
+bool lvgl_set_touch_profile(lv_obj_t* obj, const TouchFilterProfile* profile) {
+    for (TouchProfileEntry& entry : touch_profiles) {
+        if (entry.obj == obj || entry.obj == nullptr) {
+            if (entry.obj == nullptr) {
+                // Screens can be freed and rebuilt; a dead pointer must not match a new widget
+                lv_obj_add_event_cb(obj, forget_touch_profile, LV_EVENT_DELETE, NULL);
+            }
+            entry.obj = obj;
+            entry.profile = profile;
+            return true;
+        }
+    }
+    return false;
+}
+
 void lvgl_init() {
     lv_init();
 
@@ -40,11 +162,13 @@ void lvgl_init() {
     lv_display_set_flush_cb(disp, my_disp_flush);
 
     lv_display_set_buffers(disp, buf, NULL, buf_size_in_pixels, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(disp, count_invalidation, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(disp, count_render, LV_EVENT_RENDER_START, NULL);
 
     // Touch driver
-    lv_indev_t *indev = lv_indev_create();
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(indev, my_touchpad_read);
+    touch_indev = lv_indev_create();
+    lv_indev_set_type(touch_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(touch_indev, my_touchpad_read);
 
     // Encoder driver
     lv_indev_t *enc_indev = lv_indev_create();
@@ -55,4 +179,19 @@ void lvgl_init() {
     encoder_group = lv_group_create();
     lv_group_set_default(encoder_group);
     lv_indev_set_group(enc_indev, encoder_group);
-}
\ No newline at end of file
+    buttons_subscribe(on_button_event, nullptr);
+}
+
+const LvglStats& lvgl_get_stats() {
+    return stats;
+}
+
+bool lvgl_touch_owned_by_widget(int16_t x, int16_t y) {
+    if (lv_indev_get_scroll_obj(touch_indev) != nullptr) return true;
+    lv_point_t point = {x, y};
+    return is_interactive(lv_indev_search_obj(lv_screen_active(), &point));
+}
+
+void lvgl_touch_cancel() {
+    lv_indev_wait_release(touch_indev);
+}
@@ -3,13 +3,46 @@
 
 #include "globals.h"
 #include "config.h"
+#include "touch_filter.h"
 
 void lvgl_init(); // A new function to contain all LVGL setup
 
+/**
+ * @brief Redraw counters, to spot widgets that invalidate without changing.
+ */
+struct LvglStats {
+    uint32_t invalidations; // Areas marked dirty
+    uint32_t renders;       // Refreshes that had something to draw
+};
+
+const LvglStats& lvgl_get_stats();
+
 // LVGL Driver Callbacks
 void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
 void my_touchpad_read(lv_indev_t *indev, lv_indev_data_t *data);
 void my_encoder_read(lv_indev_t *indev, lv_indev_data_t *data);
 uint32_t my_tick_get_cb(void);
 
+/**
+ * @brief Tunes touch filtering for strokes that start on obj or any of its children.
+ *        Up to 8 widgets; the rest use TOUCH_PROFILE_DEFAULT. The entry is
+ *        released when the widget is deleted.
+ * @return false if the table is full.
+ */
+bool lvgl_set_touch_profile(lv_obj_t* obj, const TouchFilterProfile* profile);
+
+/**
+ * @brief Whether a touch stroke belongs to the UI rather than to the global
+ *        gestures: it started on a clickable or scrollable widget, or LVGL is
+ *        scrolling something right now.
+ * @param x, y Where the stroke's first finger came down.
+ */
+bool lvgl_touch_owned_by_widget(int16_t x, int16_t y);
+
+/**
+ * @brief Makes LVGL ignore the current touch until the finger lifts, so a
+ *        stroke used for a gesture doesn't also end in a click.
+ */
+void lvgl_touch_cancel();
+
 #endif // LVGL_HANDLER_H
\ No newline at end of file
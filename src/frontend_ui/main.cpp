@@ -7,6 +7,11 @@
 #include "mqtt.h"
 #include <WiFi.h>
 #include "music_player.h"
+#include "playback.h"
+#include "telemetry.h"
+#include "led_render.h"
+#include "beats.h"
+#include "app_state.h"
 #include "config.h"
 
 // =========================================================================
@@ -24,15 +29,7 @@ lv_obj_t *ui_Screen1 = nullptr, *ui_Screen2 = nullptr, *ui_arc = nullptr,
          *ui_progress_bar = nullptr;
 
 lv_group_t *encoder_group = nullptr;
-int currentMode = 0;
-const char *modeNames[] = {"Brightness", "Color Hue", "Position", "Volume"};
-const int totalModes = sizeof(modeNames) / sizeof(modeNames[0]); // Calculate number of modes
 
-static unsigned long lastMemCheck = 0;
-
-long encoderValue = 50;
-bool ledsOn = false;
-uint8_t lastPinA_State = HIGH, lastPinB_State = HIGH, lastEncSwitchState = HIGH, lastButton1State = HIGH, lastButton2State = HIGH;
 long last_lvgl_encoder_val = 0;
 
 // =========================================================================
@@ -57,7 +54,9 @@ void onWiFiGotIP(WiFiEvent_t event, WiFiEventInfo_t info) {
     Serial.print("[Setup] IP address: ");
     Serial.println(WiFi.localIP());
 
-    mqtt_setup();
+    // UTC is enough: the clock is only used to measure music status delivery delay
+    configTime(0, 0, Config::ntp_server);
+    mqtt_network_up();
 }
 
 // This function is CALLED AUTOMATICALLY when WiFi disconnects
@@ -78,29 +77,27 @@ void setup() {
 
     // STEP 2: Initialize hardware, display, and UI.
     hardware_init();
+    led_render_init();
     lvgl_init();
+    app_state_init();
     ui_init();
     
     // STEP 3: Initialize other application logic.
+    mqtt_setup();
     music_player_init();
+    playback_init();
+    beats_init();
 
     Serial.println("[Setup] Setup complete. Main loop is starting.");
 }
 
 void loop() {
+    telemetry_loop_tick();
     mqtt_loop();
     handle_hardware_inputs();
-    sync_ui_with_state();
-    update_volume(encoderValue);
-    update_leds();
-    FastLED.show();
-
-    if (millis() - lastMemCheck > 10000) { // Every 10 seconds
-        lastMemCheck = millis();
-        Serial.printf("Free Heap: %u bytes, Min Free Heap: %u bytes\n",
-                      ESP.getFreeHeap(), ESP.getMinFreeHeap());
-    }
-    
+
+    telemetry_loop();
+
     lv_timer_handler();
     // A small delay is crucial to prevent starving the idle task,
     delay(5);
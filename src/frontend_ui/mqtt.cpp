@@ -3,301 +3,520 @@
 #include "mqtt.h"
 #include "globals.h" // For access to ui elements and global state
 #include <PubSubClient.h>
-#include <ArduinoJson.h>
 #include <WiFi.h> // Needed for MAC address
+#include <atomic>
+#include "music_status.h"
+#include "playback.h"
+#include "buttons.h"
+#include "effects.h"
+#include "beats.h"
+#include "app_state.h"
+#include "mqtt_session.h"
+#include "mqtt_handlers.h"
 
 // --- Configuration ---
-const long MQTT_RECONNECT_INTERVAL_MS = 5000;
-#define MAX_MQTT_PAYLOAD_SIZE 256 // Increased slightly for safety with JSON
+constexpr size_t MQTT_PACKET_OVERHEAD = 5 + 2; // Fixed header and topic length of a PUBLISH
+constexpr uint32_t MQTT_CONNECT_TASK_STACK = 4096;
 
-// --- Time formatting constants ---
-const int SECONDS_PER_HOUR = 3600;
-const int SECONDS_PER_MINUTE = 60;
-const int TIME_FORMAT_THRESHOLD_HOURS = 3600;  // Format with hours if >= 1 hour
-const int TIME_FORMAT_THRESHOLD_MINUTES = 600; // Format with leading zero if >= 10 minutes
+// --- Receive Buffer ---
+static PayloadSink payload_sink; // See mqtt_dispatch.h
+
+// --- Session Tracking ---
+/**
+ * @brief WiFiClient that shows the bytes read after each connect to a ConnackCapture.
+ *
+ * PubSubClient reads the CONNACK but doesn't expose its session-present flag.
+ * Without it a broker that dropped our persistent session (restart, expiry)
+ * would leave us connected but subscribed to nothing.
+ */
+class ConnackClient : public WiFiClient {
+public:
+    using WiFiClient::read;
+
+    int read() override {
+        int byte = WiFiClient::read();
+        if (byte >= 0) connack.feed(byte);
+        return byte;
+    }
+
+    ConnackCapture connack;
+};
 
 // --- Client Objects ---
-WiFiClient espClient;
+ConnackClient espClient;
 PubSubClient client(espClient);
 
-// --- State Variables ---
-static unsigned long lastReconnectAttempt = 0;
-static MusicInfoUpdateCallback music_info_handler = nullptr;
+// --- Connection State Machine ---
+// client.connect() blocks for the TCP handshake and CONNACK, so it runs on a
+// helper task. While an attempt is in flight the main loop does not touch the client.
+enum class MqttState : uint8_t {
+    Backoff,    // Waiting for WiFi or for the retry delay to pass
+    Connecting, // Helper task is inside client.connect()
+    Connected,
+};
+
+static MqttState mqtt_state = MqttState::Backoff;
+static TaskHandle_t connect_task_handle = nullptr;
+static std::atomic<bool> connect_finished{false};
+static std::atomic<bool> connect_succeeded{false};
+static std::atomic<bool> network_changed{false}; // Set from the WiFi event task, taken by mqtt_loop()
+static unsigned long backoff_started = 0;
+static MqttBackoff backoff(Config::mqtt_backoff_min_ms, Config::mqtt_backoff_max_ms);
+static unsigned long attempt_started = 0;
+static unsigned long connected_at = 0;
+static bool first_message_seen = false;
+static bool session_subscribed = false; // Broker holds our subscriptions in a persistent session
+static char client_id[32] = "";
+static MqttStats stats = {};
 
 // --- Forward Declarations for Internal Functions ---
 void mqtt_callback(char* topic, byte* payload, unsigned int length);
 bool mqtt_connect_attempt();
+void mqtt_connect_task(void* parameter);
+void on_mqtt_connected();
+void schedule_reconnect();
 void log_mqtt_error(int8_t state);
-void handle_image_message(byte* payload, unsigned int length);
-void handle_music_message(byte* payload, unsigned int length);
-void handle_brightness_message(const char* msg_buffer);
-void handle_command_message(const char* msg_buffer);
-void format_time_label(lv_obj_t* label, int seconds);
+void register_builtin_topics();
+void service_publish_slots();
+bool send_slot(size_t index);
+bool publish_counted(const char* topic, const char* payload, bool retained);
+
+// --- Topic Dispatch Table ---
+static MqttDispatcher dispatcher;
+
+// Topics owned by this module (handlers in mqtt_handlers.cpp). Other modules
+// register their own via mqtt_register_topic().
+static constexpr MqttTopic builtin_topics[] = {
+    mqtt_topic(Config::topic_music,      MqttPayload::Binary, handle_music_message),
+    mqtt_topic(Config::topic_brightness, MqttPayload::Text,   handle_brightness_message),
+    mqtt_topic(Config::topic_command,    MqttPayload::Text,   handle_command_message),
+};
+
+// --- Coalescing Publisher ---
+struct PublishSlotState {
+    const char*   topic;
+    int32_t       value;
+    bool          pending;
+    unsigned long last_publish;
+    uint32_t      suppressed; // Values overwritten before they were sent
+};
+
+static PublishSlotState publish_slots[(size_t)PublishSlot::Count] = {
+    {Config::topic_position_set, 0, false, 0, 0},
+    {Config::topic_volume_set,   0, false, 0, 0},
+};
 
 long last_volume = -1;
 
+// --- Button Bridge ---
+static const char* const BUTTON_NAMES[BUTTON_COUNT] = {"encoder", "back", "mode"};
+
+/**
+ * @brief Forwards clicks, holds and repeats to Config::topic_button so other
+ *        automations can use the buttons. Raw press/release edges are not sent.
+ */
+static void publish_button_event(const ButtonEvent& event, void* ctx) {
+    const char* action;
+    switch (event.action) {
+        case ButtonAction::Click:       action = "click"; break;
+        case ButtonAction::DoubleClick: action = "double"; break;
+        case ButtonAction::LongPress:   action = "long"; break;
+        case ButtonAction::Repeat:      action = "repeat"; break;
+        default: return;
+    }
+    char payload[24];
+    snprintf(payload, sizeof(payload), "%s %s", BUTTON_NAMES[event.button], action);
+    mqtt_publish(Config::topic_button, payload, false);
+}
+static int player_volume = -1; // From the latest music status, or our own last nudge
+
+// --- Handler Sinks (see mqtt_handlers.h) ---
+
+static void sync_music(const MusicStatus& status) {
+    #ifdef DEBUG_MQTT
+        Serial.printf("[MQTT] Track Length: %u seconds\n", (unsigned)status.length);
+        Serial.printf("[MQTT] Elapsed Time: %u seconds\n", (unsigned)status.elapsed);
+    #endif
+
+    if (status.fields & MUSIC_FIELD_VOLUME) {
+        player_volume = status.volume;
+    }
+    playback_sync(status);
+}
+
+static void set_backlight(uint8_t level) {
+    #ifdef DEBUG_MQTT
+        Serial.printf("[MQTT] Setting brightness to: %u\n", (unsigned)level);
+    #endif
+    my_lcd.setBrightness(level);
+}
+
+static void restart_device() {
+    publish_status("rebooting");
+    delay(200);
+    ESP.restart();
+}
+
+#ifdef DEBUG_BEATS
+static void start_beat_test(uint16_t bpm) {
+    beats_load_synthetic(bpm, 4);
+}
+#endif
+
+static const MqttHandlerSinks handler_sinks = {
+    sync_music,
+    set_backlight,
+    app_state_set_leds_on,
+    restart_device,
+    #ifdef DEBUG_BEATS
+        start_beat_test,
+    #else
+        nullptr,
+    #endif
+};
+
 // =========================================================================
 // PUBLIC FUNCTIONS (as defined in mqtt.h)
 // =========================================================================
 
 void mqtt_setup() {
+    register_builtin_topics();
+
+    // The client ID is built once from the MAC address and reused, which also
+    // lets the broker recognise us and resume a persistent session.
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    snprintf(client_id, sizeof(client_id), "ESP32-Music-%02X%02X%02X%02X%02X%02X",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    buttons_subscribe(publish_button_event, nullptr);
     client.setServer(Config::broker_host, Config::broker_port);
     client.setCallback(mqtt_callback);
+    // PubSubClient builds outgoing packets in its own buffer (256 bytes by
+    // default) and refuses anything larger, which the telemetry report is.
+    if (!client.setBufferSize(MQTT_PACKET_OVERHEAD + MQTT_MAX_PUBLISH_TOPIC + MQTT_MAX_PUBLISH_PAYLOAD)) {
+        Serial.println("[MQTT] WARNING: Could not grow the client buffer, large publishes will fail!");
+    }
+    mqtt_handlers_init(handler_sinks);
+    if (payload_sink.begin(Config::mqtt_payload_capacity)) {
+        client.setStream(payload_sink);
+        Serial.printf("[MQTT] Allocated %u KB receive buffer in PSRAM.\n", (unsigned)(Config::mqtt_payload_capacity / 1024));
+    } else {
+        Serial.println("[MQTT] WARNING: No PSRAM receive buffer, long payloads will be dropped!");
+    }
+    xTaskCreatePinnedToCore(
+        mqtt_connect_task, "MqttConnect", MQTT_CONNECT_TASK_STACK, NULL, 1, &connect_task_handle, 0
+    );
     Serial.println("[MQTT] Client configured.");
 }
 
-void mqtt_loop() {
-    // If we are connected, just run the client loop and exit.
-    if (client.connected()) {
-        client.loop();
-        return;
-    }
+void mqtt_network_up() {
+    network_changed.store(true);
+}
 
-    // If we get here, we are not connected.
-    // First, check if WiFi is even up. No point trying if it's not.
-    if (WiFi.status() != WL_CONNECTED) {
-        return; 
+void mqtt_loop() {
+    switch (mqtt_state) {
+        case MqttState::Connected:
+            if (client.connected()) {
+                // client.loop() reads at most one packet, so this keeps one payload in the sink
+                payload_sink.reset();
+                client.loop();
+                service_publish_slots();
+                return;
+            }
+            Serial.println("[MQTT] Connection lost.");
+            stats.disconnects++;
+            // First retry right away, then back off
+            mqtt_state = MqttState::Backoff;
+            backoff_started = millis();
+            backoff.reset();
+            return;
+
+        case MqttState::Connecting:
+            if (!connect_finished.load()) {
+                return; // Still waiting on the helper task
+            }
+            connect_finished.store(false);
+            if (connect_succeeded.load()) {
+                on_mqtt_connected();
+            } else {
+                stats.connect_failures++;
+                schedule_reconnect();
+            }
+            return;
+
+        case MqttState::Backoff:
+            // First, check if WiFi is even up. No point trying if it's not.
+            if (WiFi.status() != WL_CONNECTED || connect_task_handle == nullptr) {
+                return;
+            }
+            // A fresh IP is a good moment to retry without waiting out the backoff
+            if (network_changed.exchange(false)) {
+                backoff.reset();
+            }
+            if (millis() - backoff_started >= backoff.delay_ms()) {
+                mqtt_state = MqttState::Connecting;
+                attempt_started = millis();
+                xTaskNotifyGive(connect_task_handle);
+            }
+            return;
     }
+}
 
-    // If WiFi is connected, but MQTT is not, try to reconnect periodically.
-    unsigned long now = millis();
-    if (now - lastReconnectAttempt > MQTT_RECONNECT_INTERVAL_MS) {
-        lastReconnectAttempt = now;
-        // Attempt to reconnect (this is our new non-blocking function)
-        if (mqtt_connect_attempt()) {
-            // Success! Reset timer to allow immediate re-check if it disconnects again.
-            lastReconnectAttempt = 0;
-        }
-    }
+bool mqtt_publish(const char* topic, const char* payload, bool retained) {
+    return is_mqtt_connected() && publish_counted(topic, payload, retained);
 }
 
 void publish_status(const char* message) {
-    if (client.connected()) {
-        client.publish(Config::topic_status, message);
+    if (is_mqtt_connected()) {
+        publish_counted(Config::topic_status, message, false);
     }
 }
 
 void publish_brightness(uint8_t brightness) {
-    if (client.connected()) {
+    if (is_mqtt_connected()) {
         char buffer[4]; // Max "255" + null terminator
         snprintf(buffer, sizeof(buffer), "%d", brightness);
-        client.publish(Config::topic_brightness, buffer, true); // Retained message
+        publish_counted(Config::topic_brightness, buffer, true); // Retained message
     }
 }
 
 void publish_elapsed_time(uint16_t elapsed) {
-    if (client.connected()) {
-        char buffer[6]; // Max "36000" for 10h + null terminator
-        snprintf(buffer, sizeof(buffer), "%u", elapsed);
-        client.publish(Config::topic_position_set, buffer, false);
-    }
+    mqtt_publish_latest(PublishSlot::Position, elapsed);
 }
 
 void update_volume(long volume) {
-    if (currentMode == 3 && last_volume != volume) { // Volume mode and volume changed
-        if (client.connected()) {
-            char buffer[4]; // Max "100" + null terminator
-            snprintf(buffer, sizeof(buffer), "%d", volume);
-            client.publish(Config::topic_volume_set, buffer, false);
-            last_volume = volume;
-        }
+    if (led_mode(app_state_mode()).controls_volume && last_volume != volume) { // Volume mode and volume changed
+        mqtt_publish_latest(PublishSlot::Volume, volume);
+        last_volume = volume;
     }
 }
 
-void register_music_info_update_callback(MusicInfoUpdateCallback callback) {
-    music_info_handler = callback;
+void nudge_volume(int steps) {
+    if (player_volume < 0) return;
+    int volume = constrain(player_volume + steps, 0, 100);
+    if (volume != player_volume) {
+        player_volume = volume;
+        mqtt_publish_latest(PublishSlot::Volume, volume);
+    }
 }
 
-bool is_mqtt_connected() {
-    return client.connected();
+void mqtt_publish_latest(PublishSlot slot, int32_t value) {
+    PublishSlotState& state = publish_slots[(size_t)slot];
+    if (state.pending) {
+        state.suppressed++;
+    }
+    state.value = value;
+    state.pending = true;
+
+    if (millis() - state.last_publish >= Config::publish_min_interval_ms) {
+        send_slot((size_t)slot);
+    }
 }
 
-// =========================================================================
-// INTERNAL "HELPER" FUNCTIONS
-// =========================================================================
+void mqtt_flush(PublishSlot slot) {
+    if (publish_slots[(size_t)slot].pending) {
+        send_slot((size_t)slot);
+    }
+}
 
-/**
- * @brief Formats and displays a time duration on an LVGL label.
- * Chooses format based on duration: H:MM:SS (>1hr), MM:SS (>10min), or M:SS (<10min).
- * @param label The LVGL label to update
- * @param seconds The duration in seconds
- */
-void format_time_label(lv_obj_t* label, int seconds) {
-    if (seconds >= TIME_FORMAT_THRESHOLD_HOURS) {
-        // Format: H:MM:SS
-        lv_label_set_text_fmt(label, "%d:%02d:%02d", 
-            seconds / SECONDS_PER_HOUR, 
-            (seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE, 
-            seconds % SECONDS_PER_MINUTE);
-    } else if (seconds >= TIME_FORMAT_THRESHOLD_MINUTES) {
-        // Format: MM:SS
-        lv_label_set_text_fmt(label, "%02d:%02d", 
-            seconds / SECONDS_PER_MINUTE, 
-            seconds % SECONDS_PER_MINUTE);
+uint32_t mqtt_publish_suppressed_count() {
+    uint32_t total = 0;
+    for (const PublishSlotState& state : publish_slots) {
+        total += state.suppressed;
+    }
+    return total;
+}
+
+bool mqtt_register_topic(const MqttTopic& entry) {
+    register_builtin_topics();
+    if (!dispatcher.add(entry)) {
+        Serial.printf("[MQTT] Could not register topic: %s\n", entry.topic);
+        return false;
+    }
+    // Topics registered after connecting still need their subscription;
+    // otherwise make sure the next connect subscribes to the whole table
+    if (is_mqtt_connected()) {
+        client.subscribe(entry.topic);
     } else {
-        // Format: M:SS
-        lv_label_set_text_fmt(label, "%d:%02d", 
-            seconds / SECONDS_PER_MINUTE, 
-            seconds % SECONDS_PER_MINUTE);
+        session_subscribed = false;
     }
+    return true;
+}
+
+bool is_mqtt_connected() {
+    return mqtt_state == MqttState::Connected;
 }
 
+const MqttStats& mqtt_get_stats() {
+    return stats;
+}
+
+void mqtt_visit_topic_stats(MqttTopicStatsVisitor visitor, void* context) {
+    dispatcher.visit_stats(visitor, context);
+}
+
+void mqtt_reset_topic_stats() {
+    dispatcher.reset_stats();
+}
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
 /**
- * @brief Handles incoming image metadata messages (JSON).
- * Invokes the music info callback with URL, track name, and artist.
+ * @brief Publishes a slot's value. Stays pending while disconnected so the
+ *        final value is still delivered after reconnecting.
+ * @return true if the value was handed to the client.
  */
-void handle_image_message(byte* payload, unsigned int length) {
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, payload, length);
-    if (error) {
-        Serial.printf("[MQTT] JSON Error: %s\n", error.c_str());
-        if (error == DeserializationError::NoMemory) {
-            Serial.println("[MQTT] FATAL: Ran out of memory parsing image JSON!");
-            Serial.printf("Free Heap: %u bytes\n", ESP.getFreeHeap());
-        }
-        return;
-    }
-    
-    if (music_info_handler && doc["url"] && doc["track"] && doc["artist"]) {
-        music_info_handler(doc["url"], doc["track"], doc["artist"]);
+bool send_slot(size_t index) {
+    PublishSlotState& state = publish_slots[index];
+    if (!is_mqtt_connected()) {
+        return false;
     }
+    char buffer[12]; // Max "-2147483648" + null terminator
+    snprintf(buffer, sizeof(buffer), "%ld", (long)state.value);
+    publish_counted(state.topic, buffer, false);
+    state.pending = false;
+    state.last_publish = millis();
+    return true;
 }
 
 /**
- * @brief Handles incoming music status messages (JSON).
- * Updates UI labels and progress bar with track length and elapsed time.
+ * @brief Publishes through the client and counts refusals. PubSubClient returns
+ *        false without a word when a packet doesn't fit its buffer.
  */
-void handle_music_message(byte* payload, unsigned int length) {
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, payload, length);
-    if (error) {
-        Serial.printf("[MQTT] JSON Error: %s\n", error.c_str());
-        return;
-    }
-    
-    if (!doc["length"].is<int>() || !doc["elapsed"].is<int>()) {
-        Serial.println("[MQTT] Music message missing required fields");
-        return;
+bool publish_counted(const char* topic, const char* payload, bool retained) {
+    if (client.publish(topic, payload, retained)) {
+        return true;
     }
-    
-    int len_sec = doc["length"];
-    int pos_sec = doc["elapsed"];
-
+    stats.publish_failures++;
     #ifdef DEBUG_MQTT
-        Serial.printf("[MQTT] Track Length: %d seconds\n", len_sec);
-        Serial.printf("[MQTT] Elapsed Time: %d seconds\n", pos_sec);
+        Serial.printf("[MQTT] Publish of %u bytes to %s failed.\n", (unsigned)strlen(payload), topic);
     #endif
-
-    // Update UI labels with formatted time
-    format_time_label(ui_length_label, len_sec);
-    format_time_label(ui_position_label, pos_sec);
-
-    // Update progress bar
-    lv_slider_set_range(ui_progress_bar, 0, len_sec > 0 ? len_sec : 1);
-    lv_slider_set_value(ui_progress_bar, constrain(pos_sec, 0, len_sec), LV_ANIM_ON);
+    return false;
 }
 
 /**
- * @brief Handles brightness control messages.
- * @param msg_buffer Null-terminated string containing brightness value (0-255)
+ * @brief Sends trailing values whose rate-limit interval has expired.
  */
-void handle_brightness_message(const char* msg_buffer) {
-    #ifdef DEBUG_MQTT
-        Serial.printf("[MQTT] Setting brightness to: %s\n", msg_buffer);
-    #endif
-    
-    int brightness = atoi(msg_buffer);
-    my_lcd.setBrightness(constrain(brightness, 0, 255));
+void service_publish_slots() {
+    unsigned long now = millis();
+    for (size_t i = 0; i < (size_t)PublishSlot::Count; i++) {
+        const PublishSlotState& state = publish_slots[i];
+        if (state.pending && now - state.last_publish >= Config::publish_min_interval_ms) {
+            send_slot(i);
+        }
+    }
 }
 
 /**
- * @brief Handles command messages (reboot, LED control, etc.).
- * @param msg_buffer Null-terminated string containing the command
+ * @brief Adds this module's own topics to the dispatch table, once.
  */
-void handle_command_message(const char* msg_buffer) {
-    #ifdef DEBUG_MQTT
-        Serial.printf("[MQTT] Command received: %s\n", msg_buffer);
-    #endif
-    
-    if (strcasecmp(msg_buffer, "reboot") == 0) {
-        Serial.println("[MQTT] Reboot command received, restarting...");
-        publish_status("rebooting");
-        delay(200);
-        ESP.restart();
-    } else if (strcasecmp(msg_buffer, "led_on") == 0) {
-        Serial.println("[MQTT] LED ON command received.");
-        ledsOn = true;
-    } else if (strcasecmp(msg_buffer, "led_off") == 0) {
-        Serial.println("[MQTT] LED OFF command received.");
-        ledsOn = false;
-    } else {
-        Serial.printf("[MQTT] Unknown command: %s\n", msg_buffer);
+void register_builtin_topics() {
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+    for (const MqttTopic& entry : builtin_topics) {
+        dispatcher.add(entry);
     }
 }
 
 /**
  * @brief The master callback function for handling all incoming MQTT messages.
- * Routes messages to appropriate handlers based on topic.
+ * Routes messages through the topic dispatch table.
  */
 void mqtt_callback(char* topic, byte* payload, unsigned int length) {
-    // For safety, copy payload to a null-terminated buffer on the stack
-    char msg_buffer[MAX_MQTT_PAYLOAD_SIZE + 1];
-    unsigned int len_to_copy = min((unsigned int)MAX_MQTT_PAYLOAD_SIZE, length);
-    memcpy(msg_buffer, payload, len_to_copy);
-    msg_buffer[len_to_copy] = '\0';
-    
+    if (!first_message_seen && dispatcher.find(topic)) {
+        first_message_seen = true;
+        stats.first_message_ms = millis() - connected_at;
+    }
+
     #ifdef DEBUG_MQTT
-        Serial.printf("[MQTT] Message on topic: %s\n", topic);
-        Serial.printf("[MQTT] Payload: %s\n", msg_buffer);
+        // The payload argument is cut off at PubSubClient's buffer size; the sink has all of it
+        Serial.printf("[MQTT] Message on topic: %s (%u bytes)\n", topic,
+                      (unsigned)(payload_sink.ready() ? payload_sink.size() : length));
     #endif
-
-    // Route to appropriate handler based on topic
-    if (strcmp(topic, Config::topic_image) == 0) {
-        handle_image_message(payload, length);
-    } 
-    else if (strcmp(topic, Config::topic_music) == 0) {
-        handle_music_message(payload, length);
-    } 
-    else if (strcmp(topic, Config::topic_brightness) == 0) {
-        handle_brightness_message(msg_buffer);
-    } 
-    else if (strcmp(topic, Config::topic_command) == 0) {
-        handle_command_message(msg_buffer);
-    }
-    else {
-        Serial.printf("[MQTT] Unknown topic: %s\n", topic);
+    switch (dispatcher.dispatch(topic, payload, length, &payload_sink)) {
+        case MqttDispatchResult::Handled:
+            break;
+        case MqttDispatchResult::UnknownTopic:
+            stats.unknown_topic++;
+            Serial.printf("[MQTT] Unknown topic: %s\n", topic);
+            break;
+        case MqttDispatchResult::Oversize:
+            stats.oversize_dropped++;
+            Serial.printf("[MQTT] Dropped %u byte payload on %s (limit %u).\n",
+                          (unsigned)(payload_sink.ready() ? payload_sink.size() : length), topic,
+                          (unsigned)(payload_sink.ready() ? payload_sink.capacity() : MqttDispatcher::FALLBACK_PAYLOAD_SIZE));
+            break;
     }
 }
 
 /**
- * @brief Attempts to connect to the MQTT broker ONCE and returns immediately.
+ * @brief Attempts to connect to the MQTT broker ONCE. Blocks until the broker
+ *        answers or times out, so it only runs on the connect task.
  * @return True on success, false on failure.
  */
 bool mqtt_connect_attempt() {
-    Serial.print("[MQTT] Attempting connection...");
-
-    // OPTIMIZATION: Use the device's MAC address for a unique client ID.
-    // This avoids String allocations and potential client ID collisions.
-    String clientId = "ESP32-Music-";
-    clientId += WiFi.macAddress();
-    
-    if (client.connect(clientId.c_str(), Config::broker_user, Config::broker_pass)) {
-        Serial.println(" Connected!");
-        publish_status("online");
-
-        // Resubscribe to all topics upon (re)connection
-        client.subscribe(Config::topic_command);
-        client.subscribe(Config::topic_brightness);
-        client.subscribe(Config::topic_image);
-        client.subscribe(Config::topic_music);
-        
-        Serial.println("[MQTT] Subscribed to all topics.");
+    Serial.println("[MQTT] Attempting connection...");
+
+    espClient.connack.arm(); // Keep the CONNACK for its session-present flag
+
+    // No last will; cleanSession is off when persistent sessions are enabled
+    if (client.connect(client_id, Config::broker_user, Config::broker_pass,
+                       nullptr, 0, false, nullptr, !Config::mqtt_persistent_session)) {
         return true;
-    } else {
-        // Use our helper to print a detailed error message
-        log_mqtt_error(client.state());
-        return false;
     }
+    // Use our helper to print a detailed error message
+    log_mqtt_error(client.state());
+    return false;
+}
+
+/**
+ * @brief Runs blocking connection attempts off the main loop, one per notification.
+ */
+void mqtt_connect_task(void* parameter) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        connect_succeeded.store(mqtt_connect_attempt());
+        connect_finished.store(true);
+    }
+}
+
+/**
+ * @brief Finishes a successful attempt on the main loop: subscriptions, status and metrics.
+ */
+void on_mqtt_connected() {
+    mqtt_state = MqttState::Connected;
+    connected_at = millis();
+    first_message_seen = false;
+    stats.connects++;
+    stats.connect_time_ms = connected_at - attempt_started;
+    backoff.reset();
+    bool session_present = espClient.connack.session_present();
+    Serial.printf("[MQTT] Connected in %u ms (%s session).\n", (unsigned)stats.connect_time_ms,
+                  session_present ? "resumed" : "new");
+
+    publish_status("online");
+
+    // A CONNACK without session-present means the broker lost our subscriptions
+    if (mqtt_needs_subscribe(Config::mqtt_persistent_session, session_present, session_subscribed)) {
+        // One pass over the dispatch table; PubSubClient doesn't wait for SUBACKs
+        dispatcher.visit_stats([](const char* topic, const MqttTopicStats&, void*) { client.subscribe(topic); }, nullptr);
+        session_subscribed = true;
+        Serial.printf("[MQTT] Subscribed to %u topics.\n", (unsigned)dispatcher.count());
+    }
+}
+
+/**
+ * @brief Enters backoff after a failure. Delays double up to the configured cap,
+ *        with +/-25% jitter so devices don't reconnect in lockstep.
+ */
+void schedule_reconnect() {
+    mqtt_state = MqttState::Backoff;
+    backoff_started = millis();
+    backoff.fail(esp_random());
 }
 
 /**
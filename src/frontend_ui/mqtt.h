@@ -6,21 +6,90 @@
 #include <Arduino.h>
 #include "globals.h"
 #include "config.h"
+#include "mqtt_dispatch.h" // Topic table types, see mqtt_register_topic()
 
-using MusicInfoUpdateCallback = void (*)(const char* url, const char* track, const char* artist);
+// Largest payload mqtt_publish() can send, e.g. the telemetry report. The
+// client's buffer is sized for this plus the packet header and topic.
+constexpr size_t MQTT_MAX_PUBLISH_PAYLOAD = 1024;
+constexpr size_t MQTT_MAX_PUBLISH_TOPIC = 64;
+
+// =========================================================================
+// COALESCING PUBLISHER
+// =========================================================================
+
+/**
+ * @brief Latest-value-wins slots for high-rate controls. Each slot publishes at
+ *        most once per Config::publish_min_interval_ms; intermediate values are
+ *        dropped, but the last value is always sent once the interval expires.
+ */
+enum class PublishSlot : uint8_t {
+    Position, // Config::topic_position_set
+    Volume,   // Config::topic_volume_set
+    Count
+};
+
+/**
+ * @brief Stores a new value for a slot and publishes it if the slot's interval allows.
+ * @param slot The slot to update.
+ * @param value The new value; replaces any value still waiting to be sent.
+ */
+void mqtt_publish_latest(PublishSlot slot, int32_t value);
+
+/**
+ * @brief Publishes a slot's pending value right away, ignoring the rate limit.
+ *        Use at the end of a gesture (e.g. LV_EVENT_RELEASED) to deliver the final value.
+ */
+void mqtt_flush(PublishSlot slot);
+
+/**
+ * @brief Number of values that were replaced before being published, across all slots.
+ */
+uint32_t mqtt_publish_suppressed_count();
+
+/**
+ * @brief Connection health counters, updated by mqtt_loop().
+ */
+struct MqttStats {
+    uint32_t connects;         // Successful connections since boot
+    uint32_t connect_failures; // Attempts the broker refused or that timed out
+    uint32_t disconnects;      // Established connections that were lost
+    uint32_t connect_time_ms;  // Duration of the last successful attempt
+    uint32_t first_message_ms; // Time from the last connect to its first message, 0 until one arrives
+    uint32_t oversize_dropped; // Payloads larger than Config::mqtt_payload_capacity
+    uint32_t unknown_topic;    // Messages on topics missing from the dispatch table
+    uint32_t publish_failures; // Publishes the client refused, e.g. too large or a dead socket
+};
 
 /**
  * @brief Initializes the MQTT client and sets up the server and callback.
- *        Does NOT connect yet. Call from your main setup().
+ *        Does NOT connect yet. Call once from your main setup(), after WiFi.mode().
  */
 void mqtt_setup();
 
 /**
- * @brief Connects/reconnects to the MQTT broker and subscribes to topics.
- *        This function should be called from the main loop() to handle disconnections.
+ * @brief Tells the reconnect state machine that the network came (back) up,
+ *        so it retries without waiting out the backoff. Only sets a flag, so
+ *        it is safe to call from the WiFi event task.
+ */
+void mqtt_network_up();
+
+/**
+ * @brief Runs the client and drives the reconnect state machine. Never blocks:
+ *        connection attempts run on a helper task, retried with exponential
+ *        backoff and jitter. Call from the main loop().
  */
 void mqtt_loop();
 
+/**
+ * @brief Publishes a message if connected.
+ * @param topic The topic to publish to.
+ * @param payload The null-terminated payload.
+ * @param retained Whether the broker should keep it for new subscribers.
+ * @return true if the message was handed to the client. Failures while
+ *         connected are counted in MqttStats::publish_failures.
+ */
+bool mqtt_publish(const char* topic, const char* payload, bool retained);
+
 /**
  * @brief Publishes a status message to Config::topic_status.
  * @param message The null-terminated string to publish.
@@ -35,16 +104,26 @@ void publish_brightness(uint8_t brightness);
 
 /**
  * @brief Publishes the current elapsed time value to Config::topic_position_set.
+ *        Rate limited through PublishSlot::Position.
  * @param elapsed The elapsed time in seconds.
  */
 void publish_elapsed_time(uint16_t elapsed);
 
 /**
  * @brief Publishes the current volume value to Config::topic_volume_set if in Volume mode.
+ *        Rate limited through PublishSlot::Volume. Called whenever state_value changes.
  * @param volume The volume value (0-100).
  */
 void update_volume(long volume);
 
+/**
+ * @brief Changes the player volume relative to the last value reported in a music
+ *        status message, independent of the current mode. Does nothing until a
+ *        volume is known. Rate limited through PublishSlot::Volume.
+ * @param steps Percentage points, positive = louder.
+ */
+void nudge_volume(int steps);
+
 /**
  * @brief Checks if the MQTT client is currently connected.
  * @return true if connected, false otherwise.
@@ -52,9 +131,26 @@ void update_volume(long volume);
 bool is_mqtt_connected();
 
 /**
- * @brief Registers the function to be called when new music info is received
- * @param callback The function to call with the parsed URL, track, and artist.
+ * @brief Connection health counters for telemetry.
+ */
+const MqttStats& mqtt_get_stats();
+
+/**
+ * @brief Calls the visitor once for every registered topic with its handler statistics.
+ */
+void mqtt_visit_topic_stats(MqttTopicStatsVisitor visitor, void* context);
+
+/**
+ * @brief Clears all per-topic handler statistics, e.g. after they were reported.
+ */
+void mqtt_reset_topic_stats();
+
+/**
+ * @brief Adds a topic to the dispatch table and subscribes to it on every (re)connect.
+ *        Modules call this from their init function to own their topics.
+ * @param entry The table entry, usually built with mqtt_topic().
+ * @return false if the topic is already registered or the table is full.
  */
-void register_music_info_update_callback(MusicInfoUpdateCallback callback);
+bool mqtt_register_topic(const MqttTopic& entry);
 
 #endif // MQTT_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+// src/frontend_ui/mqtt_dispatch.cpp
+
+#include "mqtt_dispatch.h"
+
+static_assert((MqttDispatcher::SLOTS & (MqttDispatcher::SLOTS - 1)) == 0, "slot count must be a power of two");
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in mqtt_dispatch.h)
+// =========================================================================
+
+bool MqttDispatcher::add(const MqttTopic& entry) {
+    if (count_ >= SLOTS / 2 || find(entry.topic)) {
+        return false;
+    }
+    for (size_t i = 0; i < SLOTS; i++) {
+        MqttTopic& slot = slots_[(entry.hash + i) & (SLOTS - 1)];
+        if (slot.topic == nullptr) {
+            slot = entry;
+            count_++;
+            return true;
+        }
+    }
+    return false;
+}
+
+const MqttTopic* MqttDispatcher::find(const char* topic) const {
+    const uint32_t hash = mqtt_topic_hash(topic);
+    for (size_t i = 0; i < SLOTS; i++) {
+        const MqttTopic& slot = slots_[(hash + i) & (SLOTS - 1)];
+        if (slot.topic == nullptr) {
+            return nullptr; // Empty slot ends the probe sequence
+        }
+        if (slot.hash == hash && strcmp(slot.topic, topic) == 0) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+MqttDispatchResult MqttDispatcher::dispatch(const char* topic, const uint8_t* payload, unsigned int length,
+                                            PayloadSink* sink) {
+    const MqttTopic* entry = find(topic);
+    if (entry == nullptr) {
+        return MqttDispatchResult::UnknownTopic;
+    }
+    const size_t slot = entry - slots_;
+
+    if (sink && sink->ready()) {
+        if (sink->overflowed()) {
+            return MqttDispatchResult::Oversize;
+        }
+        run_handler(slot, sink->terminated(), sink->size());
+        return MqttDispatchResult::Handled;
+    }
+
+    if (length > FALLBACK_PAYLOAD_SIZE) {
+        return MqttDispatchResult::Oversize;
+    }
+    char msg_buffer[FALLBACK_PAYLOAD_SIZE + 1];
+    memcpy(msg_buffer, payload, length);
+    msg_buffer[length] = '\0';
+    run_handler(slot, msg_buffer, length);
+    return MqttDispatchResult::Handled;
+}
+
+void MqttDispatcher::visit_stats(MqttTopicStatsVisitor visitor, void* context) const {
+    for (size_t i = 0; i < SLOTS; i++) {
+        if (slots_[i].topic) visitor(slots_[i].topic, stats_[i], context);
+    }
+}
+
+void MqttDispatcher::reset_stats() {
+    for (MqttTopicStats& entry : stats_) {
+        entry.messages = 0;
+        entry.latency_us.reset();
+    }
+}
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+/**
+ * @brief Calls a topic's handler and records how long it took.
+ */
+void MqttDispatcher::run_handler(size_t slot, const char* payload, unsigned int length) {
+    uint32_t started = micros();
+    slots_[slot].handler(payload, length);
+    stats_[slot].latency_us.record(micros() - started);
+    stats_[slot].messages++;
+}
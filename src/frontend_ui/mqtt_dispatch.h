@@ -0,0 +1,172 @@
+// src/frontend_ui/mqtt_dispatch.h
+
+#ifndef MQTT_DISPATCH_H
+#define MQTT_DISPATCH_H
+
+#include <Arduino.h>
+#include "latency_histogram.h"
+
+// =========================================================================
+// MESSAGE PATH
+// Everything between PubSubClient handing over a PUBLISH and a topic's
+// handler returning: the receive buffer, the topic table and the per-topic
+// timing. No client, WiFi or UI here, so the path can be replayed off-target.
+// =========================================================================
+
+/**
+ * @brief How a handler wants its payload delivered.
+ */
+enum class MqttPayload : uint8_t {
+    Text,   // Text such as commands or numbers
+    Json,   // Raw bytes as received, handed straight to the JSON parser
+    Binary, // Raw bytes as received, decoded by the handler (e.g. MessagePack)
+};
+
+/**
+ * @brief Handler for one topic. The payload points straight into the receive
+ *        buffer and is always null-terminated; it is only valid during the call.
+ */
+using MqttTopicHandler = void (*)(const char* payload, unsigned int length);
+
+/**
+ * @brief FNV-1a hash of a topic string. constexpr so topic tables are hashed at compile time.
+ */
+constexpr uint32_t mqtt_topic_hash(const char* topic, uint32_t hash = 2166136261u) {
+    return *topic ? mqtt_topic_hash(topic + 1, (hash ^ (uint8_t)*topic) * 16777619u) : hash;
+}
+
+struct MqttTopic {
+    const char*      topic;
+    uint32_t         hash;
+    MqttPayload      kind;
+    MqttTopicHandler handler;
+};
+
+/**
+ * @brief Builds a topic table entry with its hash computed at compile time.
+ */
+constexpr MqttTopic mqtt_topic(const char* topic, MqttPayload kind, MqttTopicHandler handler) {
+    return MqttTopic{topic, mqtt_topic_hash(topic), kind, handler};
+}
+
+/**
+ * @brief Per-topic message path cost, measured around each handler call.
+ */
+struct MqttTopicStats {
+    uint32_t         messages;
+    LatencyHistogram latency_us;
+};
+
+using MqttTopicStatsVisitor = void (*)(const char* topic, const MqttTopicStats& stats, void* context);
+
+// =========================================================================
+// RECEIVE BUFFER
+// =========================================================================
+
+/**
+ * @brief Stream that PubSubClient writes every PUBLISH payload into, byte by byte.
+ *
+ * PubSubClient keeps only the first bufferSize bytes of a packet and silently
+ * drops longer ones. With a stream attached it instead forwards the full payload
+ * here, so its own buffer only has to hold the topic. The sink lives in PSRAM,
+ * is sized by Config::mqtt_payload_capacity, and is reset before each packet.
+ */
+class PayloadSink : public Stream {
+public:
+    bool begin(size_t capacity) {
+        data_ = (uint8_t*) ps_malloc(capacity + 1); // +1 for the terminator
+        capacity_ = data_ ? capacity : 0;
+        return data_ != nullptr;
+    }
+
+    size_t write(uint8_t byte) override {
+        if (size_ < capacity_) data_[size_] = byte;
+        size_++; // Keeps counting past capacity so oversize payloads are detected
+        return 1;
+    }
+
+    void reset() { size_ = 0; }
+    bool ready() const { return data_ != nullptr; }
+    bool overflowed() const { return size_ > capacity_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Null-terminates in place; only valid when the payload fit
+    const char* terminated() {
+        data_[size_] = '\0';
+        return (const char*)data_;
+    }
+
+    // Write-only stream
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+};
+
+// =========================================================================
+// TOPIC DISPATCH TABLE
+// =========================================================================
+
+/**
+ * @brief What became of one incoming message.
+ */
+enum class MqttDispatchResult : uint8_t {
+    Handled,
+    UnknownTopic, // Not in the table
+    Oversize,     // Larger than the sink (or the fallback buffer without one)
+};
+
+/**
+ * @brief Topic table with per-topic handler timing.
+ *
+ * Open-addressed by the compile-time topic hash, so lookup cost does not grow
+ * with the number of topics. The slot count is a power of two and at least
+ * twice the number of topics it accepts.
+ */
+class MqttDispatcher {
+public:
+    static constexpr size_t SLOTS = 16;
+    static constexpr size_t FALLBACK_PAYLOAD_SIZE = 256; // Stack copy when there is no sink
+
+    /**
+     * @brief Places an entry in the first free slot of its probe sequence.
+     * @return false if the topic is already present or the table is full.
+     */
+    bool add(const MqttTopic& entry);
+
+    /**
+     * @brief Looks up a topic.
+     * @return The matching entry, or nullptr for unknown topics.
+     */
+    const MqttTopic* find(const char* topic) const;
+
+    /**
+     * @brief Routes one message from PubSubClient's callback to its handler and
+     *        times the handler. With a ready sink the payload is taken from it,
+     *        since the callback's copy is cut off at the client's buffer size;
+     *        without one the callback's bytes are copied and terminated on the stack.
+     */
+    MqttDispatchResult dispatch(const char* topic, const uint8_t* payload, unsigned int length, PayloadSink* sink);
+
+    /**
+     * @brief Calls the visitor once for every topic with its handler statistics.
+     */
+    void visit_stats(MqttTopicStatsVisitor visitor, void* context) const;
+
+    void reset_stats();
+    size_t count() const { return count_; }
+
+private:
+    void run_handler(size_t slot, const char* payload, unsigned int length);
+
+    MqttTopic slots_[SLOTS] = {};
+    MqttTopicStats stats_[SLOTS] = {}; // Parallel to slots_
+    size_t count_ = 0;
+};
+
+#endif // MQTT_DISPATCH_H
@@ -0,0 +1,50 @@
+// src/frontend_ui/mqtt_handlers.cpp
+
+#include "mqtt_handlers.h"
+
+// --- State Variables ---
+static MqttHandlerSinks sinks = {};
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in mqtt_handlers.h)
+// =========================================================================
+
+void mqtt_handlers_init(const MqttHandlerSinks& handler_sinks) {
+    sinks = handler_sinks;
+}
+
+/**
+ * @brief Hands the decoded snapshot on; the playback clock drives the labels and progress bar.
+ */
+void handle_music_message(const char* payload, unsigned int length) {
+    MusicStatus status;
+    if (!music_status_decode((const uint8_t*)payload, length, status)) {
+        Serial.println("[MQTT] Music message invalid or missing required fields");
+        return;
+    }
+    sinks.music(status);
+}
+
+void handle_brightness_message(const char* msg_buffer, unsigned int length) {
+    int brightness = atoi(msg_buffer);
+    sinks.brightness(constrain(brightness, 0, 255));
+}
+
+void handle_command_message(const char* msg_buffer, unsigned int length) {
+    if (strcasecmp(msg_buffer, "reboot") == 0) {
+        Serial.println("[MQTT] Reboot command received, restarting...");
+        sinks.reboot();
+    } else if (strcasecmp(msg_buffer, "led_on") == 0) {
+        Serial.println("[MQTT] LED ON command received.");
+        sinks.leds_on(true);
+    } else if (strcasecmp(msg_buffer, "led_off") == 0) {
+        Serial.println("[MQTT] LED OFF command received.");
+        sinks.leds_on(false);
+    } else if (sinks.beat_test && strncasecmp(msg_buffer, "beat_test", 9) == 0) {
+        // "beat_test [bpm]": a synthetic schedule to check beat timing without the bridge
+        int bpm = atoi(msg_buffer + 9);
+        sinks.beat_test(bpm > 0 ? bpm : 120);
+    } else {
+        Serial.printf("[MQTT] Unknown command: %s\n", msg_buffer);
+    }
+}
@@ -0,0 +1,50 @@
+// src/frontend_ui/mqtt_handlers.h
+
+#ifndef MQTT_HANDLERS_H
+#define MQTT_HANDLERS_H
+
+#include <Arduino.h>
+#include "music_status.h"
+
+// =========================================================================
+// BUILT-IN TOPIC HANDLERS
+// The music, brightness and command topics. The handlers parse and decide;
+// what they change on the device goes through the sinks below, so the same
+// handlers run on the host against stubs.
+// =========================================================================
+
+/**
+ * @brief Where the handlers deliver their results. Every entry except
+ *        beat_test must be set.
+ */
+struct MqttHandlerSinks {
+    void (*music)(const MusicStatus& status); // Decoded music status
+    void (*brightness)(uint8_t level);        // Backlight, 0-255
+    void (*leds_on)(bool on);                 // "led_on" / "led_off"
+    void (*reboot)();                         // "reboot"; does not return on the device
+    void (*beat_test)(uint16_t bpm);          // "beat_test [bpm]"; nullptr leaves the command unknown
+};
+
+/**
+ * @brief Sets the sinks. Call before the first message can arrive.
+ */
+void mqtt_handlers_init(const MqttHandlerSinks& sinks);
+
+/**
+ * @brief Music status messages (MessagePack or JSON), see music_status.h.
+ */
+void handle_music_message(const char* payload, unsigned int length);
+
+/**
+ * @brief Brightness control messages.
+ * @param msg_buffer Null-terminated string containing brightness value (0-255)
+ */
+void handle_brightness_message(const char* msg_buffer, unsigned int length);
+
+/**
+ * @brief Command messages (reboot, LED control, etc.).
+ * @param msg_buffer Null-terminated string containing the command
+ */
+void handle_command_message(const char* msg_buffer, unsigned int length);
+
+#endif // MQTT_HANDLERS_H
@@ -0,0 +1,93 @@
+// src/frontend_ui/mqtt_session.h
+
+#ifndef MQTT_SESSION_H
+#define MQTT_SESSION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =========================================================================
+// RECONNECT AND SESSION POLICY
+// The decisions of the reconnect state machine in mqtt.cpp, without the
+// client, the clock or the random source, so they can be driven off-target.
+// =========================================================================
+
+/**
+ * @brief Exponential reconnect backoff. Each failure doubles the base delay up
+ *        to the cap; the delay handed out is the base +/-25%, so devices that
+ *        lost the same broker don't reconnect in lockstep.
+ */
+class MqttBackoff {
+public:
+    MqttBackoff(uint32_t min_ms, uint32_t max_ms) : min_ms_(min_ms), max_ms_(max_ms) {}
+
+    /**
+     * @brief Records a failed attempt.
+     * @param random Any 32-bit random number, e.g. esp_random().
+     * @return Delay before the next attempt.
+     */
+    uint32_t fail(uint32_t random) {
+        if (base_ms_ == 0) {
+            base_ms_ = min_ms_;
+        } else {
+            base_ms_ = base_ms_ > max_ms_ / 2 ? max_ms_ : base_ms_ * 2;
+        }
+        delay_ms_ = base_ms_ - base_ms_ / 4 + random % (base_ms_ / 2 + 1);
+        return delay_ms_;
+    }
+
+    /**
+     * @brief Next attempt right away, and the next failure starts over at the minimum.
+     */
+    void reset() {
+        base_ms_ = 0;
+        delay_ms_ = 0;
+    }
+
+    uint32_t delay_ms() const { return delay_ms_; } // 0 = try right away
+
+private:
+    uint32_t min_ms_;
+    uint32_t max_ms_;
+    uint32_t base_ms_ = 0;
+    uint32_t delay_ms_ = 0;
+};
+
+/**
+ * @brief Keeps the first four bytes received after arm(), which on a new
+ *        connection are the CONNACK: 0x20, remaining length 2, ack flags
+ *        (bit 0: session present) and the return code.
+ */
+class ConnackCapture {
+public:
+    void arm() { captured_ = 0; }
+
+    void feed(uint8_t byte) {
+        if (captured_ < sizeof(bytes_)) bytes_[captured_++] = byte;
+    }
+
+    bool accepted() const {
+        return captured_ == sizeof(bytes_) && bytes_[0] == 0x20 && bytes_[1] == 0x02 && bytes_[3] == 0;
+    }
+
+    bool session_present() const { return accepted() && (bytes_[2] & 0x01); }
+
+private:
+    uint8_t bytes_[4] = {};
+    size_t captured_ = sizeof(bytes_); // Not armed
+};
+
+/**
+ * @brief Whether to subscribe to the dispatch table after connecting.
+ * @param persistent Connected with cleanSession off.
+ * @param session_present The CONNACK's session-present flag.
+ * @param table_subscribed The whole table was subscribed in this broker session,
+ *        and no topic was registered while offline since.
+ */
+inline bool mqtt_needs_subscribe(bool persistent, bool session_present, bool table_subscribed) {
+    // A resumed session still holds the subscriptions; subscribing again would
+    // only make the broker replay every retained message
+    return !(persistent && session_present && table_subscribed);
+}
+
+#endif // MQTT_SESSION_H
@@ -0,0 +1,59 @@
+// src/frontend_ui/music_image.cpp
+
+#include "music_image.h"
+#include <ArduinoJson.h>
+#include "json_arena.h"
+
+// --- Configuration ---
+constexpr size_t IMAGE_JSON_ARENA_SIZE = 4096; // One variant pool plus url, track and artist
+
+// Image metadata is parsed into a reused static arena; the filter drops everything but url/track/artist
+static JsonArena<IMAGE_JSON_ARENA_SIZE> image_json_arena;
+static JsonDocument image_filter;
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+static void copy_field(char* dest, size_t size, const char* value) {
+    strncpy(dest, value, size - 1);
+    dest[size - 1] = '\0';
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in music_image.h)
+// =========================================================================
+
+bool music_image_decode(const char* payload, size_t length, MusicInfo& out) {
+    static bool filter_built = false;
+    if (!filter_built) {
+        // Built once and kept for the lifetime of the program
+        image_filter["url"] = true;
+        image_filter["track"] = true;
+        image_filter["artist"] = true;
+        image_filter.shrinkToFit();
+        filter_built = true;
+    }
+
+    image_json_arena.reset();
+    JsonDocument doc(&image_json_arena);
+    DeserializationError error = deserializeJson(doc, payload, length, DeserializationOption::Filter(image_filter));
+    if (error) {
+        Serial.printf("[Music Player] JSON Error: %s\n", error.c_str());
+        if (error == DeserializationError::NoMemory) {
+            Serial.printf("[Music Player] Image JSON arena exhausted (%u bytes).\n", (unsigned)image_json_arena.capacity());
+        }
+        return false;
+    }
+
+    const char* url = doc["url"];
+    const char* track = doc["track"];
+    const char* artist = doc["artist"];
+    if (!url || !track || !artist) {
+        return false;
+    }
+    copy_field(out.url, sizeof(out.url), url);
+    copy_field(out.track, sizeof(out.track), track);
+    copy_field(out.artist, sizeof(out.artist), artist);
+    return true;
+}
@@ -0,0 +1,32 @@
+// src/frontend_ui/music_image.h
+
+#ifndef MUSIC_IMAGE_H
+#define MUSIC_IMAGE_H
+
+#include <Arduino.h>
+
+/*
+ * The image topic carries the artwork of the current track as JSON:
+ *
+ *   {"url":"http://.../cover.png","track":"...","artist":"...", ...}
+ *
+ * Only url, track and artist are read; other fields are skipped by the
+ * parse filter. Longer strings are cut to the fields below.
+ */
+struct MusicInfo {
+    char url[256];
+    char track[128];
+    char artist[128];
+};
+
+/**
+ * @brief Decodes an image metadata payload. Parses into a reused static arena,
+ *        so it makes no heap calls.
+ * @param payload The raw JSON bytes.
+ * @param length The number of bytes in payload.
+ * @param out Filled on success, null-terminated.
+ * @return true if the payload was valid JSON with url, track and artist.
+ */
+bool music_image_decode(const char* payload, size_t length, MusicInfo& out);
+
+#endif // MUSIC_IMAGE_H
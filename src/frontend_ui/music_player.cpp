@@ -2,15 +2,9 @@
 #include "globals.h"
 #include "mqtt.h"
 #include <HTTPClient.h>
-#include <string.h> // For strncpy
+#include "music_image.h"
 
 // --- Task Communication ---
-struct MusicInfo {
-    char url[256];
-    char track[128];
-    char artist[128];
-};
-
 static QueueHandle_t music_info_queue;
 
 // --- Private Data ---
@@ -144,16 +138,19 @@ void download_image_task(void* parameter) {
 // =========================================================================
 // MQTT CALLBACK
 // =========================================================================
-static void on_music_info_update(const char* url, const char* track, const char* artist) {    
-    MusicInfo new_info = {0};
-
-    strncpy(new_info.url, url, sizeof(new_info.url) - 1);
-    strncpy(new_info.track, track, sizeof(new_info.track) - 1);
-    strncpy(new_info.artist, artist, sizeof(new_info.artist) - 1);
-
-    xQueueSend(music_info_queue, &new_info, portMAX_DELAY);
+/**
+ * @brief Handles incoming image metadata messages (JSON).
+ * Queues the URL, track name, and artist for the download task.
+ */
+static void handle_image_message(const char* payload, unsigned int length) {
+    MusicInfo new_info;
+    if (music_image_decode(payload, length, new_info)) {
+        xQueueSend(music_info_queue, &new_info, portMAX_DELAY);
+    }
 }
 
+static constexpr MqttTopic image_topic = mqtt_topic(Config::topic_image, MqttPayload::Json, handle_image_message);
+
 // =========================================================================
 // PUBLIC INIT FUNCTION
 // =========================================================================
@@ -173,5 +170,5 @@ void music_player_init() {
         download_image_task, "ImageDownloader", 8192, NULL, 1, NULL, 0
     );
 
-    register_music_info_update_callback(on_music_info_update);
+    mqtt_register_topic(image_topic);
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+// src/frontend_ui/music_status.cpp
+
+#include "music_status.h"
+#include <ArduinoJson.h>
+#include "json_arena.h"
+
+// --- Configuration ---
+constexpr size_t MUSIC_JSON_ARENA_SIZE = 2048; // One variant pool plus the filtered fields
+
+// --- MessagePack map keys (see music_status.h) ---
+enum MusicStatusKey : uint8_t {
+    KEY_LENGTH  = 0,
+    KEY_ELAPSED = 1,
+    KEY_PLAYING = 2,
+    KEY_SHUFFLE = 3,
+    KEY_VOLUME  = 4,
+    KEY_TS      = 5,
+};
+
+// --- JSON Fallback ---
+// Parsed into a reused static arena instead of the heap. The filter keeps only the fields we read.
+static JsonArena<MUSIC_JSON_ARENA_SIZE> music_json_arena;
+static JsonDocument music_filter;
+
+// =========================================================================
+// MESSAGEPACK DECODER
+// =========================================================================
+
+/**
+ * @brief Minimal forward-only MessagePack reader over the payload buffer.
+ * Decodes scalars in place without copying; nested containers are rejected.
+ */
+struct MsgPackReader {
+    const uint8_t* pos;
+    const uint8_t* end;
+
+    bool read_byte(uint8_t& value) {
+        if (pos >= end) return false;
+        value = *pos++;
+        return true;
+    }
+
+    bool read_be(size_t bytes, uint64_t& value) {
+        if ((size_t)(end - pos) < bytes) return false;
+        value = 0;
+        for (size_t i = 0; i < bytes; i++) value = (value << 8) | *pos++;
+        return true;
+    }
+
+    bool read_map_size(uint32_t& size) {
+        uint8_t type;
+        if (!read_byte(type)) return false;
+        if ((type & 0xF0) == 0x80) { size = type & 0x0F; return true; } // fixmap
+        uint64_t value;
+        if (type == 0xDE && read_be(2, value)) { size = value; return true; } // map 16
+        return false;
+    }
+
+    bool read_uint(uint64_t& value) {
+        uint8_t type;
+        if (!read_byte(type)) return false;
+        if (type <= 0x7F) { value = type; return true; } // positive fixint
+        switch (type) {
+            case 0xCC: return read_be(1, value);
+            case 0xCD: return read_be(2, value);
+            case 0xCE: return read_be(4, value);
+            case 0xCF: return read_be(8, value);
+            default:   return false;
+        }
+    }
+
+    bool read_bool(bool& value) {
+        uint8_t type;
+        if (!read_byte(type) || (type != 0xC2 && type != 0xC3)) return false;
+        value = (type == 0xC3);
+        return true;
+    }
+
+    /**
+     * @brief Skips the value of an unknown key. Only scalars, strings and binaries are supported.
+     */
+    bool skip() {
+        uint8_t type;
+        uint64_t size;
+        if (!read_byte(type)) return false;
+        if (type <= 0x7F || type >= 0xE0) return true;          // fixint
+        if ((type & 0xE0) == 0xA0) return advance(type & 0x1F); // fixstr
+        switch (type) {
+            case 0xC0: case 0xC2: case 0xC3: return true;       // nil, bool
+            case 0xCC: case 0xD0: return advance(1);
+            case 0xCD: case 0xD1: return advance(2);
+            case 0xCA: case 0xCE: case 0xD2: return advance(4);
+            case 0xCB: case 0xCF: case 0xD3: return advance(8);
+            case 0xC4: case 0xD9: return read_be(1, size) && advance(size); // bin 8, str 8
+            case 0xC5: case 0xDA: return read_be(2, size) && advance(size); // bin 16, str 16
+            default:   return false;
+        }
+    }
+
+    bool advance(uint64_t bytes) {
+        if ((uint64_t)(end - pos) < bytes) return false;
+        pos += bytes;
+        return true;
+    }
+};
+
+static bool is_msgpack_map(uint8_t first_byte) {
+    return (first_byte & 0xF0) == 0x80 || first_byte == 0xDE;
+}
+
+static bool decode_msgpack(const uint8_t* payload, size_t length, MusicStatus& out) {
+    MsgPackReader reader{payload, payload + length};
+    uint32_t entries;
+    if (!reader.read_map_size(entries)) return false;
+
+    bool has_length = false, has_elapsed = false;
+    for (uint32_t i = 0; i < entries; i++) {
+        uint64_t key, value;
+        bool flag;
+        if (!reader.read_uint(key)) return false;
+        switch (key) {
+            case KEY_LENGTH:
+                if (!reader.read_uint(value)) return false;
+                out.length = value;
+                has_length = true;
+                break;
+            case KEY_ELAPSED:
+                if (!reader.read_uint(value)) return false;
+                out.elapsed = value;
+                has_elapsed = true;
+                break;
+            case KEY_PLAYING:
+                if (!reader.read_bool(flag)) return false;
+                out.playing = flag;
+                out.fields |= MUSIC_FIELD_PLAYING;
+                break;
+            case KEY_SHUFFLE:
+                if (!reader.read_bool(flag)) return false;
+                out.shuffle = flag;
+                out.fields |= MUSIC_FIELD_SHUFFLE;
+                break;
+            case KEY_VOLUME:
+                if (!reader.read_uint(value)) return false;
+                out.volume = min(value, (uint64_t)100);
+                out.fields |= MUSIC_FIELD_VOLUME;
+                break;
+            case KEY_TS:
+                if (!reader.read_uint(value)) return false;
+                out.timestamp = value;
+                out.fields |= MUSIC_FIELD_TIMESTAMP;
+                break;
+            default:
+                if (!reader.skip()) return false;
+                break;
+        }
+    }
+    return has_length && has_elapsed;
+}
+
+// =========================================================================
+// JSON DECODER
+// =========================================================================
+
+static bool decode_json(const uint8_t* payload, size_t length, MusicStatus& out) {
+    static bool filter_built = false;
+    if (!filter_built) {
+        // Built once and kept for the lifetime of the program
+        music_filter["length"] = true;
+        music_filter["elapsed"] = true;
+        music_filter["playing"] = true;
+        music_filter["shuffle"] = true;
+        music_filter["volume"] = true;
+        music_filter["ts"] = true;
+        music_filter.shrinkToFit();
+        filter_built = true;
+    }
+
+    music_json_arena.reset();
+    JsonDocument doc(&music_json_arena);
+    DeserializationError error = deserializeJson(doc, payload, length, DeserializationOption::Filter(music_filter));
+    if (error) {
+        Serial.printf("[Music] JSON Error: %s\n", error.c_str());
+        if (error == DeserializationError::NoMemory) {
+            Serial.printf("[Music] JSON arena exhausted (%u bytes).\n", (unsigned)music_json_arena.capacity());
+        }
+        return false;
+    }
+
+    if (!doc["length"].is<int>() || !doc["elapsed"].is<int>()) {
+        return false;
+    }
+    out.length = doc["length"];
+    out.elapsed = doc["elapsed"];
+
+    if (doc["playing"].is<bool>()) {
+        out.playing = doc["playing"];
+        out.fields |= MUSIC_FIELD_PLAYING;
+    }
+    if (doc["shuffle"].is<bool>()) {
+        out.shuffle = doc["shuffle"];
+        out.fields |= MUSIC_FIELD_SHUFFLE;
+    }
+    if (doc["volume"].is<int>()) {
+        out.volume = constrain(doc["volume"].as<int>(), 0, 100);
+        out.fields |= MUSIC_FIELD_VOLUME;
+    }
+    if (doc["ts"].is<uint64_t>()) {
+        out.timestamp = doc["ts"];
+        out.fields |= MUSIC_FIELD_TIMESTAMP;
+    }
+
+    #ifdef DEBUG_MQTT
+        Serial.printf("[Music] JSON arena high water: %u/%u bytes\n",
+                      (unsigned)music_json_arena.high_water(), (unsigned)music_json_arena.capacity());
+    #endif
+    return true;
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in music_status.h)
+// =========================================================================
+
+bool music_status_decode(const uint8_t* payload, size_t length, MusicStatus& out) {
+    memset(&out, 0, sizeof(out));
+    if (length == 0) return false;
+
+    if (is_msgpack_map(payload[0])) {
+        return decode_msgpack(payload, length, out);
+    }
+    return decode_json(payload, length, out);
+}
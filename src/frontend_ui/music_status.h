@@ -0,0 +1,50 @@
+// src/frontend_ui/music_status.h
+
+#ifndef MUSIC_STATUS_H
+#define MUSIC_STATUS_H
+
+#include <Arduino.h>
+
+/*
+ * The music status topic accepts two encodings, told apart by the first byte:
+ *
+ *   JSON (fallback):  {"length":204,"elapsed":107,"playing":true,...}
+ *   MessagePack:      a map with small integer keys, e.g. 82 00 CC CC 01 6B
+ *
+ *   key  JSON name  type        meaning
+ *   0    length     uint        Track length in seconds (required)
+ *   1    elapsed    uint        Elapsed time in seconds (required)
+ *   2    playing    bool        Playback running
+ *   3    shuffle    bool        Shuffle enabled
+ *   4    volume     uint        Player volume, 0-100
+ *   5    ts         uint        Sender's clock when the message was built, ms since epoch
+ *
+ * Unknown keys are skipped in both encodings, so fields can be added later.
+ */
+
+// Bits in MusicStatus::fields telling which optional fields were present
+constexpr uint8_t MUSIC_FIELD_PLAYING   = 1 << 0;
+constexpr uint8_t MUSIC_FIELD_SHUFFLE   = 1 << 1;
+constexpr uint8_t MUSIC_FIELD_VOLUME    = 1 << 2;
+constexpr uint8_t MUSIC_FIELD_TIMESTAMP = 1 << 3;
+
+struct MusicStatus {
+    uint32_t length;    // Seconds
+    uint32_t elapsed;   // Seconds
+    bool     playing;
+    bool     shuffle;
+    uint8_t  volume;    // 0-100
+    uint64_t timestamp; // ms since epoch, 0 if not sent
+    uint8_t  fields;    // MUSIC_FIELD_* bits
+};
+
+/**
+ * @brief Decodes a music status payload in either encoding.
+ * @param payload The raw message bytes.
+ * @param length The number of bytes in payload.
+ * @param out Filled on success; optional fields not present are zeroed.
+ * @return true if the payload was valid and contained length and elapsed.
+ */
+bool music_status_decode(const uint8_t* payload, size_t length, MusicStatus& out);
+
+#endif // MUSIC_STATUS_H
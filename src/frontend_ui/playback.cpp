@@ -0,0 +1,174 @@
+// src/frontend_ui/playback.cpp
+
+#include "playback.h"
+#include "globals.h" // For access to ui elements
+#include <sys/time.h>
+#include <esp_timer.h>
+
+// --- Configuration ---
+constexpr uint32_t PLAYBACK_TIMER_PERIOD_MS = 1000 / PLAYBACK_SLIDER_STEPS_PER_SECOND;
+constexpr uint32_t MAX_DELIVERY_DELAY_MS = 10000; // Larger gaps mean one of the clocks is not synced
+constexpr time_t   MIN_SYNCED_EPOCH = 1700000000; // Anything earlier means SNTP has not run yet
+
+// --- Time formatting constants ---
+const int SECONDS_PER_HOUR = 3600;
+const int SECONDS_PER_MINUTE = 60;
+const int TIME_FORMAT_THRESHOLD_HOURS = 3600;  // Format with hours if >= 1 hour
+const int TIME_FORMAT_THRESHOLD_MINUTES = 600; // Format with leading zero if >= 10 minutes
+
+// --- State Variables ---
+struct PlaybackSnapshot {
+    uint32_t length_ms;
+    uint32_t elapsed_ms; // Position at anchor_us
+    int64_t  anchor_us;  // esp_timer_get_time() when elapsed_ms was valid; 64-bit so
+                         // a long track without status messages can't wrap it
+    bool     playing;
+};
+
+// Written by the loop task, also read by the LED task's beat scheduler
+static portMUX_TYPE snapshot_lock = portMUX_INITIALIZER_UNLOCKED;
+static PlaybackSnapshot snapshot = {0, 0, 0, false};
+static int shown_length_s = -1;   // What the length label currently shows
+static int shown_position_s = -1; // What the position label currently shows
+static uint32_t last_reported_s = 0; // Elapsed time from the previous status message
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+/**
+ * @brief Formats and displays a time duration on an LVGL label.
+ * Chooses format based on duration: H:MM:SS (>1hr), MM:SS (>10min), or M:SS (<10min).
+ * @param label The LVGL label to update
+ * @param seconds The duration in seconds
+ */
+static void format_time_label(lv_obj_t* label, int seconds) {
+    if (seconds >= TIME_FORMAT_THRESHOLD_HOURS) {
+        // Format: H:MM:SS
+        lv_label_set_text_fmt(label, "%d:%02d:%02d",
+            seconds / SECONDS_PER_HOUR,
+            (seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE,
+            seconds % SECONDS_PER_MINUTE);
+    } else if (seconds >= TIME_FORMAT_THRESHOLD_MINUTES) {
+        // Format: MM:SS
+        lv_label_set_text_fmt(label, "%02d:%02d",
+            seconds / SECONDS_PER_MINUTE,
+            seconds % SECONDS_PER_MINUTE);
+    } else {
+        // Format: M:SS
+        lv_label_set_text_fmt(label, "%d:%02d",
+            seconds / SECONDS_PER_MINUTE,
+            seconds % SECONDS_PER_MINUTE);
+    }
+}
+
+/**
+ * @brief Milliseconds the status message spent in transit, if both clocks are synced.
+ */
+static uint32_t delivery_delay_ms(const MusicStatus& status) {
+    if (!(status.fields & MUSIC_FIELD_TIMESTAMP)) return 0;
+
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    if (now.tv_sec < MIN_SYNCED_EPOCH) return 0;
+
+    uint64_t now_ms = (uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+    if (now_ms < status.timestamp || now_ms - status.timestamp > MAX_DELIVERY_DELAY_MS) return 0;
+    return now_ms - status.timestamp;
+}
+
+/**
+ * @brief Redraws the labels and progress bar from the extrapolated position.
+ * Labels only change once per second; the slider is left alone while the user drags it.
+ */
+static void refresh_widgets() {
+    int length_s = snapshot.length_ms / 1000;
+    uint32_t position_ms = playback_position_ms();
+    int position_s = position_ms / 1000;
+
+    if (length_s != shown_length_s) {
+        shown_length_s = length_s;
+        format_time_label(ui_length_label, length_s);
+        lv_slider_set_range(ui_progress_bar, 0, length_s > 0 ? length_s * PLAYBACK_SLIDER_STEPS_PER_SECOND : 1);
+    }
+    if (position_s != shown_position_s) {
+        shown_position_s = position_s;
+        format_time_label(ui_position_label, position_s);
+    }
+    if (!lv_obj_has_state(ui_progress_bar, LV_STATE_PRESSED)) {
+        lv_slider_set_value(ui_progress_bar, position_ms * PLAYBACK_SLIDER_STEPS_PER_SECOND / 1000, LV_ANIM_OFF);
+    }
+}
+
+static void playback_timer_cb(lv_timer_t* timer) {
+    // Nothing moves while paused; snapshots and seeks refresh the widgets themselves
+    if (snapshot.playing) {
+        refresh_widgets();
+    }
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in playback.h)
+// =========================================================================
+
+void playback_init() {
+    lv_timer_create(playback_timer_cb, PLAYBACK_TIMER_PERIOD_MS, NULL);
+}
+
+void playback_sync(const MusicStatus& status) {
+    uint32_t elapsed_ms = status.elapsed * 1000;
+    bool playing;
+    if (status.fields & MUSIC_FIELD_PLAYING) {
+        playing = status.playing;
+    } else {
+        // Older bridges don't send the state: treat an advancing position as playing
+        playing = (status.elapsed != last_reported_s && snapshot.length_ms != 0);
+    }
+    last_reported_s = status.elapsed;
+    if (playing) {
+        elapsed_ms += delivery_delay_ms(status);
+    }
+
+    #ifdef DEBUG_MQTT
+        int32_t drift_ms = (int32_t)(elapsed_ms - playback_position_ms());
+        Serial.printf("[Playback] Snapshot %u/%u ms, %s, drift %d ms\n",
+                      (unsigned)elapsed_ms, (unsigned)(status.length * 1000), playing ? "playing" : "paused", (int)drift_ms);
+    #endif
+
+    portENTER_CRITICAL(&snapshot_lock);
+    snapshot.length_ms = status.length * 1000;
+    snapshot.elapsed_ms = elapsed_ms;
+    snapshot.anchor_us = esp_timer_get_time();
+    snapshot.playing = playing;
+    portEXIT_CRITICAL(&snapshot_lock);
+    refresh_widgets();
+}
+
+void playback_seek(uint32_t position_s) {
+    portENTER_CRITICAL(&snapshot_lock);
+    snapshot.elapsed_ms = position_s * 1000;
+    snapshot.anchor_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&snapshot_lock);
+    refresh_widgets();
+}
+
+uint32_t playback_position_ms() {
+    return playback_position_us() / 1000;
+}
+
+uint64_t playback_position_us() {
+    portENTER_CRITICAL(&snapshot_lock);
+    PlaybackSnapshot current = snapshot;
+    portEXIT_CRITICAL(&snapshot_lock);
+
+    uint64_t position_us = (uint64_t)current.elapsed_ms * 1000;
+    if (current.playing) {
+        position_us += esp_timer_get_time() - current.anchor_us;
+    }
+    uint64_t length_us = (uint64_t)current.length_ms * 1000;
+    return position_us < length_us ? position_us : length_us;
+}
+
+bool playback_is_playing() {
+    return snapshot.playing;
+}
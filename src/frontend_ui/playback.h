@@ -0,0 +1,50 @@
+// src/frontend_ui/playback.h
+
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#include <Arduino.h>
+#include "music_status.h"
+
+// The progress slider counts in quarter seconds so it moves smoothly between status messages
+constexpr int32_t PLAYBACK_SLIDER_STEPS_PER_SECOND = 4;
+
+/**
+ * @brief Starts the LVGL timer that advances the position label and progress bar.
+ *        Call after ui_init().
+ */
+void playback_init();
+
+/**
+ * @brief Takes a new playback snapshot from a music status message.
+ *        The local clock is re-anchored here, and only here, to correct drift.
+ * @param status The decoded status; its ts field (if present and the clock is
+ *        synced) is used to compensate for delivery delay.
+ */
+void playback_sync(const MusicStatus& status);
+
+/**
+ * @brief Moves the local clock to a position the user picked, ahead of the bridge confirming it.
+ * @param position_s The new position in seconds.
+ */
+void playback_seek(uint32_t position_s);
+
+/**
+ * @brief The extrapolated playback position.
+ * @return Milliseconds into the current track, clamped to its length.
+ */
+uint32_t playback_position_ms();
+
+/**
+ * @brief The extrapolated playback position at full timer resolution, for the beat
+ *        scheduler. Safe to call from other tasks.
+ * @return Microseconds into the current track, clamped to its length.
+ */
+uint64_t playback_position_us();
+
+/**
+ * @brief Whether the track is currently playing according to the last snapshot.
+ */
+bool playback_is_playing();
+
+#endif // PLAYBACK_H
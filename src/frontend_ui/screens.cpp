@@ -0,0 +1,201 @@
+// src/frontend_ui/screens.cpp
+
+#include "screens.h"
+#include <Arduino.h>
+
+// --- Configuration ---
+constexpr uint32_t SLIDE_TIME_MS = 250;
+constexpr size_t   MAX_STACK_DEPTH = 8;
+constexpr size_t   TRIM_BELOW_FREE_BYTES = 40 * 1024; // Internal heap, where LVGL's small allocations land
+constexpr uint32_t TRIM_CHECK_MS = 1000;
+
+// --- State Variables ---
+static const ScreenDef* screen_defs = nullptr;
+static lv_obj_t* screens[(size_t)ScreenId::Count] = {};
+static ScreenId nav_stack[MAX_STACK_DEPTH];
+static size_t nav_depth = 0;
+
+// A slide in progress: a throwaway screen with two snapshot images
+struct Transition {
+    lv_obj_t*      screen;   // nullptr when no slide is running
+    lv_obj_t*      target;   // Real screen loaded when the slide ends
+    lv_obj_t*      from_img;
+    lv_obj_t*      to_img;
+    lv_draw_buf_t* from_snap;
+    lv_draw_buf_t* to_snap;
+    int32_t        direction; // +1: new screen comes from the right
+    int32_t        width;
+};
+
+static Transition transition = {};
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+static void on_screen_deleted(lv_event_t* e) {
+    size_t index = (size_t)(uintptr_t)lv_event_get_user_data(e);
+    screens[index] = nullptr;
+}
+
+static lv_obj_t* get_or_create(ScreenId id) {
+    size_t index = (size_t)id;
+    if (screens[index] == nullptr) {
+        screens[index] = screen_defs[index].create();
+        lv_obj_add_event_cb(screens[index], on_screen_deleted, LV_EVENT_DELETE, (void*)(uintptr_t)index);
+    }
+    return screens[index];
+}
+
+static void slide_step(void* var, int32_t offset) {
+    Transition& t = *static_cast<Transition*>(var);
+    lv_obj_set_x(t.from_img, -t.direction * offset);
+    lv_obj_set_x(t.to_img, t.direction * (t.width - offset));
+}
+
+/**
+ * @brief Loads the real screen and drops the slide, whether it ran out or was cut short.
+ */
+static void finish_transition() {
+    if (transition.screen == nullptr) return;
+    lv_anim_delete(&transition, slide_step);
+    lv_screen_load(transition.target);
+    lv_obj_delete(transition.screen); // The images go with it, before their buffers
+    lv_draw_buf_destroy(transition.from_snap);
+    lv_draw_buf_destroy(transition.to_snap);
+    transition = {};
+}
+
+static void slide_completed(lv_anim_t* anim) {
+    finish_transition();
+}
+
+/**
+ * @brief Snapshots both screens and slides the pictures. Only the two images
+ *        are redrawn per frame; the real widget trees stay untouched.
+ * @return false if a snapshot didn't fit in memory (the caller loads directly).
+ */
+static bool start_slide(lv_obj_t* from, lv_obj_t* to, int32_t direction) {
+    lv_obj_update_layout(to); // A freshly built screen has no coordinates yet
+    lv_draw_buf_t* from_snap = lv_snapshot_take(from, LV_COLOR_FORMAT_RGB565);
+    if (from_snap == nullptr) return false;
+    lv_draw_buf_t* to_snap = lv_snapshot_take(to, LV_COLOR_FORMAT_RGB565);
+    if (to_snap == nullptr) {
+        lv_draw_buf_destroy(from_snap);
+        return false;
+    }
+
+    lv_obj_t* screen = lv_obj_create(NULL);
+    lv_obj_remove_style_all(screen);
+    lv_obj_remove_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    transition.screen = screen;
+    transition.target = to;
+    transition.from_snap = from_snap;
+    transition.to_snap = to_snap;
+    transition.direction = direction;
+    transition.width = lv_display_get_horizontal_resolution(NULL);
+    transition.from_img = lv_image_create(screen);
+    lv_image_set_src(transition.from_img, from_snap);
+    transition.to_img = lv_image_create(screen);
+    lv_image_set_src(transition.to_img, to_snap);
+    slide_step(&transition, 0);
+    lv_screen_load(screen);
+
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, &transition);
+    lv_anim_set_exec_cb(&anim, slide_step);
+    lv_anim_set_values(&anim, 0, transition.width);
+    lv_anim_set_duration(&anim, SLIDE_TIME_MS);
+    lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
+    lv_anim_set_completed_cb(&anim, slide_completed);
+    lv_anim_start(&anim);
+    return true;
+}
+
+static void trim_if_low() {
+    size_t free_bytes = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    if (free_bytes >= TRIM_BELOW_FREE_BYTES) return;
+    int freed = screens_trim();
+    if (freed > 0) {
+        Serial.printf("[Screens] Low memory (%u bytes free): freed %d screen(s)\n", (unsigned)free_bytes, freed);
+    }
+}
+
+static void trim_timer_cb(lv_timer_t* timer) {
+    trim_if_low();
+}
+
+/**
+ * @brief Shows a screen, building it if needed.
+ * @param direction +1 forward, -1 back, 0 without animation.
+ */
+static void show(ScreenId id, int32_t direction) {
+    finish_transition(); // A new move jumps to the end of the running one
+    lv_obj_t* from = lv_screen_active();
+    lv_obj_t* to = get_or_create(id);
+    if (from == to) return;
+    if (direction == 0 || from == nullptr || !start_slide(from, to, direction)) {
+        lv_screen_load(to);
+    }
+    trim_if_low();
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in screens.h)
+// =========================================================================
+
+void screens_init(const ScreenDef* defs, ScreenId home) {
+    screen_defs = defs;
+    nav_stack[0] = home;
+    nav_depth = 1;
+    show(home, 0);
+    lv_timer_create(trim_timer_cb, TRIM_CHECK_MS, NULL);
+}
+
+void screens_push(ScreenId id) {
+    if (id == screens_current()) return;
+
+    // Already further down: go back to it rather than stacking a loop
+    for (size_t i = 0; i < nav_depth; i++) {
+        if (nav_stack[i] == id) {
+            nav_depth = i + 1;
+            show(id, -1);
+            return;
+        }
+    }
+    if (nav_depth < MAX_STACK_DEPTH) {
+        nav_depth++;
+    }
+    nav_stack[nav_depth - 1] = id; // A full stack replaces its top
+    show(id, 1);
+}
+
+void screens_pop() {
+    if (nav_depth <= 1) return;
+    nav_depth--;
+    show(nav_stack[nav_depth - 1], -1);
+}
+
+void screens_home() {
+    if (nav_depth <= 1) return;
+    nav_depth = 1;
+    show(nav_stack[0], -1);
+}
+
+ScreenId screens_current() {
+    return nav_stack[nav_depth - 1];
+}
+
+int screens_trim() {
+    int freed = 0;
+    for (size_t i = 0; i < (size_t)ScreenId::Count; i++) {
+        lv_obj_t* screen = screens[i];
+        if (screen == nullptr || screen_defs[i].keep_alive) continue;
+        if (screen == lv_screen_active() || screen == transition.target) continue;
+        lv_obj_delete(screen); // on_screen_deleted() clears the slot
+        freed++;
+    }
+    return freed;
+}
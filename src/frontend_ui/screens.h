@@ -0,0 +1,64 @@
+// src/frontend_ui/screens.h
+
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include <lvgl.h>
+
+// =========================================================================
+// SCREEN MANAGER
+// A navigation stack over lazily created screens. Screens are built on first
+// visit; screens not on display may be deleted when the heap runs low and are
+// rebuilt on the next visit. Moves between screens slide two snapshots, so an
+// animation frame is two image blits instead of two widget trees.
+// =========================================================================
+
+enum class ScreenId : uint8_t {
+    Display,  // Album art and playback (home)
+    Controls, // LED arc, mode and power
+    Count
+};
+
+/**
+ * @brief How to build one screen.
+ */
+struct ScreenDef {
+    lv_obj_t* (*create)(); // Builds the screen and its widgets; returns the screen object
+    bool keep_alive;       // Never freed, e.g. because timers write to its widgets
+};
+
+/**
+ * @brief Takes the screen table (indexed by ScreenId) and shows the home screen.
+ *        Call after lvgl_init() and ui_styles_init().
+ */
+void screens_init(const ScreenDef* defs, ScreenId home);
+
+/**
+ * @brief Navigates forward, sliding in from the right. A screen already on the
+ *        stack is returned to instead of pushed twice.
+ */
+void screens_push(ScreenId id);
+
+/**
+ * @brief Back to the previous screen, sliding in from the left. Does nothing on the home screen.
+ */
+void screens_pop();
+
+/**
+ * @brief Back to the home screen, clearing the stack.
+ */
+void screens_home();
+
+/**
+ * @brief The screen on top of the stack (the one shown, or being slid in).
+ */
+ScreenId screens_current();
+
+/**
+ * @brief Deletes every off-screen screen that isn't keep_alive. Runs by itself
+ *        when the heap is low; callable directly, e.g. before a large allocation.
+ * @return Screens freed.
+ */
+int screens_trim();
+
+#endif // SCREENS_H
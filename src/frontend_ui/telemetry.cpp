@@ -0,0 +1,206 @@
+// src/frontend_ui/telemetry.cpp
+
+#include "telemetry.h"
+#include "config.h"
+#include "mqtt.h"
+#include "latency_histogram.h"
+#include "inputs.h"
+#include "i2c_bus.h"
+#include "buttons.h"
+#include "led_render.h"
+#include "beats.h"
+#include "lvgl_handler.h"
+#include <WiFi.h>
+
+// --- Configuration ---
+constexpr size_t TELEMETRY_BUFFER_SIZE = MQTT_MAX_PUBLISH_PAYLOAD; // The client can't send more
+
+// --- State Variables ---
+static LatencyHistogram loop_period_us; // Reset after every report
+static uint32_t last_tick_us = 0;
+static unsigned long last_report = 0;
+static uint32_t report_truncations = 0; // Sections and handler entries left out for lack of room, since boot
+
+// Counters at the previous report, for per-second rates
+static uint32_t previous_port_reads = 0;
+static uint32_t previous_expander_transactions = 0;
+
+// Looked up by name once the owning modules have created them
+static TaskHandle_t loop_task = nullptr;
+static TaskHandle_t image_task = nullptr;
+static TaskHandle_t mqtt_connect_task = nullptr;
+static TaskHandle_t led_task = nullptr;
+
+// =========================================================================
+// INTERNAL "HELPER" FUNCTIONS
+// =========================================================================
+
+struct ReportWriter {
+    char*  buffer;
+    size_t size;
+    size_t used;
+    bool   first;
+};
+
+/**
+ * @brief Appends one topic's handler cost as "topic":[messages,p50_us,p99_us,max_us].
+ */
+static void append_topic_stats(const char* topic, const MqttTopicStats& stats, void* context) {
+    ReportWriter& writer = *static_cast<ReportWriter*>(context);
+    if (stats.messages == 0 || writer.used >= writer.size) return;
+    int written = snprintf(writer.buffer + writer.used, writer.size - writer.used, "%s\"%s\":[%u,%u,%u,%u]",
+                           writer.first ? "" : ",", topic, (unsigned)stats.messages,
+                           (unsigned)stats.latency_us.percentile(50), (unsigned)stats.latency_us.percentile(99),
+                           (unsigned)stats.latency_us.max());
+    if (written <= 0 || (size_t)written >= writer.size - writer.used) {
+        writer.buffer[writer.used] = '\0'; // Leave out an entry that doesn't fit rather than the whole section
+        report_truncations++;
+        return;
+    }
+    writer.used += written;
+    writer.first = false;
+}
+
+/**
+ * @brief Free stack words of a task at its deepest point so far, or -1 if it doesn't exist yet.
+ */
+static int stack_high_water(TaskHandle_t& handle, const char* name) {
+    if (handle == nullptr) {
+        handle = xTaskGetHandle(name);
+        if (handle == nullptr) return -1;
+    }
+    return uxTaskGetStackHighWaterMark(handle);
+}
+
+/**
+ * @brief Publishes one section of the report, retained, on "<topic_telemetry>/<section>".
+ * @param written What snprintf() returned for the section.
+ */
+static void publish_section(const char* section, const char* json, int written) {
+    if (written <= 0 || written >= (int)TELEMETRY_BUFFER_SIZE) {
+        report_truncations++;
+        Serial.printf("[Telemetry] The %s section needs %d bytes, the buffer has %u; not sent.\n",
+                      section, written, (unsigned)TELEMETRY_BUFFER_SIZE);
+        return;
+    }
+    char topic[MQTT_MAX_PUBLISH_TOPIC];
+    snprintf(topic, sizeof(topic), "%s/%s", Config::topic_telemetry, section);
+    if (!mqtt_publish(topic, json, true)) {
+        Serial.printf("[Telemetry] The %s section (%d bytes) was not sent.\n", section, written);
+    }
+}
+
+/**
+ * @brief Starts the next reporting interval. Runs after every report, sent or not,
+ *        so one failed report doesn't fold two intervals into the next one.
+ */
+static void reset_interval_stats(LatencyHistogram& touch_latency, BeatStats& beats) {
+    loop_period_us.reset();
+    mqtt_reset_topic_stats();
+    i2c_bus_reset_latency();
+    touch_latency.reset();
+    beats.lateness_us.reset();
+}
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in telemetry.h)
+// =========================================================================
+
+void telemetry_loop_tick() {
+    uint32_t now = micros();
+    if (last_tick_us != 0) {
+        loop_period_us.record(now - last_tick_us);
+    } else {
+        loop_task = xTaskGetCurrentTaskHandle();
+    }
+    last_tick_us = now;
+}
+
+void telemetry_loop() {
+    unsigned long now = millis();
+    if (now - last_report < Config::telemetry_interval_ms || !is_mqtt_connected()) {
+        return;
+    }
+    uint32_t interval_ms = now - last_report;
+    last_report = now;
+
+    const MqttStats& mqtt = mqtt_get_stats();
+    LatencyHistogram& touch_latency = inputs_touch_latency();
+    const I2cDeviceStats& touch_bus = i2c_bus_get_stats(I2cDevice::Touch);
+    const I2cDeviceStats& expander_bus = i2c_bus_get_stats(I2cDevice::Expander);
+    BeatStats& beats = beats_get_stats();
+    const InputStats& inputs = inputs_get_stats();
+    const LedRenderStats& led = led_render_get_stats();
+    static char buffer[TELEMETRY_BUFFER_SIZE]; // Static: keeps the loop stack small
+
+    // One message per section. With every number at its widest the sections
+    // take at most 425, 370 and 186 bytes, well inside the buffer.
+    int written = snprintf(buffer, sizeof(buffer),
+        "{\"up\":%lu,"
+        "\"heap\":%u,\"heap_min\":%u,\"heap_blk\":%u,"
+        "\"psram\":%u,\"psram_blk\":%u,"
+        "\"stk_loop\":%d,\"stk_img\":%d,\"stk_mqtt\":%d,\"stk_led\":%d,"
+        "\"loop_p50\":%u,\"loop_p99\":%u,\"loop_max\":%u,"
+        "\"rssi\":%d,"
+        "\"mq_conn\":%u,\"mq_fail\":%u,\"mq_disc\":%u,\"mq_big\":%u,\"mq_supp\":%u,\"mq_pub_fail\":%u,"
+        "\"tlm_trunc\":%u}",
+        now / 1000,
+        (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+        (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL),
+        (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL),
+        (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+        (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM),
+        stack_high_water(loop_task, "loopTask"),
+        stack_high_water(image_task, "ImageDownloader"),
+        stack_high_water(mqtt_connect_task, "MqttConnect"),
+        stack_high_water(led_task, "LedRender"),
+        (unsigned)loop_period_us.percentile(50),
+        (unsigned)loop_period_us.percentile(99),
+        (unsigned)loop_period_us.max(),
+        (int)WiFi.RSSI(),
+        (unsigned)mqtt.connects, (unsigned)mqtt.connect_failures, (unsigned)mqtt.disconnects,
+        (unsigned)mqtt.oversize_dropped, (unsigned)mqtt_publish_suppressed_count(),
+        (unsigned)mqtt.publish_failures,
+        (unsigned)report_truncations);
+    publish_section("system", buffer, written);
+
+    written = snprintf(buffer, sizeof(buffer),
+        "{\"io_int\":%u,\"io_rd\":%u,\"io_stuck\":%u,\"io_tch\":%u,\"tch_int\":%u,\"tch_lat\":[%u,%u,%u],"
+        "\"enc_det\":%u,\"enc_bad\":%u,\"ev_drop\":%u,\"btn_bounce\":%u,"
+        "\"i2c_tch\":[%u,%u,%u],\"i2c_io\":[%u,%u,%u],\"io_rd_s\":%u,\"i2c_io_s\":%u,"
+        "\"ui_inval\":%u,\"ui_render\":%u}",
+        (unsigned)inputs.interrupts, (unsigned)inputs.port_reads, (unsigned)inputs.int_stuck,
+        (unsigned)inputs.touch_reads, (unsigned)inputs.touch_interrupts,
+        (unsigned)touch_latency.percentile(50), (unsigned)touch_latency.percentile(99), (unsigned)touch_latency.max(),
+        (unsigned)inputs.encoder_detents, (unsigned)inputs.encoder_invalid,
+        (unsigned)inputs.events_dropped, (unsigned)buttons_bounce_count(),
+        (unsigned)touch_bus.transactions, (unsigned)touch_bus.errors, (unsigned)touch_bus.latency_us.percentile(99),
+        (unsigned)expander_bus.transactions, (unsigned)expander_bus.errors, (unsigned)expander_bus.latency_us.percentile(99),
+        (unsigned)((uint64_t)(inputs.port_reads - previous_port_reads) * 1000 / interval_ms),
+        (unsigned)((uint64_t)(expander_bus.transactions - previous_expander_transactions) * 1000 / interval_ms),
+        (unsigned)lvgl_get_stats().invalidations, (unsigned)lvgl_get_stats().renders);
+    publish_section("io", buffer, written);
+    previous_port_reads = inputs.port_reads;
+    previous_expander_transactions = expander_bus.transactions;
+
+    written = snprintf(buffer, sizeof(buffer),
+        "{\"led_show\":%u,\"led_skip\":%u,\"led_reuse\":%u,\"led_us_max\":%u,"
+        "\"fx_us_max\":%u,\"fx_over\":%u,\"frame_us_max\":%u,\"frame_over\":%u,"
+        "\"beat\":[%u,%u,%u],\"beat_late\":[%u,%u,%u]}",
+        (unsigned)led.frames_shown, (unsigned)led.frames_skipped, (unsigned)led.effects_reused,
+        (unsigned)led.render_us_max, (unsigned)led.effect_us_max, (unsigned)led.effect_over_budget,
+        (unsigned)led.frame_us_max, (unsigned)led.frame_over_budget,
+        (unsigned)beats.schedules, (unsigned)beats.fired, (unsigned)beats.skipped,
+        (unsigned)beats.lateness_us.percentile(50), (unsigned)beats.lateness_us.percentile(99), (unsigned)beats.lateness_us.max());
+    publish_section("led", buffer, written);
+
+    // Message path cost per topic since the last report; gets the whole buffer
+    buffer[0] = '{';
+    ReportWriter writer = {buffer, sizeof(buffer) - 1, 1, true}; // Room for the closing brace
+    buffer[1] = '\0';
+    mqtt_visit_topic_stats(append_topic_stats, &writer);
+    strcpy(buffer + writer.used, "}");
+    publish_section("handlers", buffer, writer.used + 1);
+
+    reset_interval_stats(touch_latency, beats);
+}
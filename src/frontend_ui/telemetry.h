@@ -0,0 +1,23 @@
+// src/frontend_ui/telemetry.h
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Records the time since the previous call as one loop period.
+ *        Call once at the top of loop(); costs a micros() read and a histogram increment.
+ */
+void telemetry_loop_tick();
+
+/**
+ * @brief Samples device health every Config::telemetry_interval_ms and publishes
+ *        it as retained JSON messages on Config::topic_telemetry plus "/system",
+ *        "/io", "/led" and "/handlers". Call from the main loop(); does nothing
+ *        between intervals. "/io" also carries io_rd_s and i2c_io_s, the expander
+ *        port reads and I2C transactions per second since the previous report.
+ */
+void telemetry_loop();
+
+#endif // TELEMETRY_H
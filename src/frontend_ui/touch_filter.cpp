@@ -0,0 +1,78 @@
+// src/frontend_ui/touch_filter.cpp
+
+#include "touch_filter.h"
+#include <math.h>
+
+// --- Configuration ---
+constexpr float MIN_DT_S = 0.001f; // Samples closer than this are treated as 1 ms apart
+constexpr float MAX_DT_S = 0.1f;   // A gap longer than this says nothing about velocity
+
+// =========================================================================
+// ONE EURO FILTER
+// =========================================================================
+
+/**
+ * @brief Exponential smoothing factor for a first-order low-pass at the given cutoff.
+ */
+static float smoothing_alpha(float cutoff_hz, float dt_s) {
+    float tau = 1.0f / (2.0f * (float)M_PI * cutoff_hz);
+    return 1.0f / (1.0f + tau / dt_s);
+}
+
+void OneEuroFilter::reset(float value) {
+    value_ = value;
+    velocity_ = 0;
+}
+
+float OneEuroFilter::filter(float value, float dt_s, const TouchFilterProfile& profile) {
+    float raw_velocity = (value - value_) / dt_s;
+    velocity_ += smoothing_alpha(profile.d_cutoff_hz, dt_s) * (raw_velocity - velocity_);
+
+    float cutoff = profile.min_cutoff_hz + profile.beta * fabsf(velocity_);
+    value_ += smoothing_alpha(cutoff, dt_s) * (value - value_);
+    return value_;
+}
+
+// =========================================================================
+// TOUCH FILTER
+// =========================================================================
+
+void TouchFilter::begin(int16_t x, int16_t y, uint32_t time_us) {
+    x_.reset(x);
+    y_.reset(y);
+    last_us_ = time_us;
+}
+
+void TouchFilter::update(int16_t x, int16_t y, uint32_t time_us) {
+    float dt_s = (time_us - last_us_) * 1e-6f;
+    last_us_ = time_us;
+    if (dt_s > MAX_DT_S) {
+        // The finger stopped for a while; don't let an old position drag this one
+        begin(x, y, time_us);
+        return;
+    }
+    if (dt_s < MIN_DT_S) dt_s = MIN_DT_S;
+    x_.filter(x, dt_s, profile_);
+    y_.filter(y, dt_s, profile_);
+}
+
+void TouchFilter::filtered(int16_t& x, int16_t& y) const {
+    x = (int16_t)lroundf(x_.value());
+    y = (int16_t)lroundf(y_.value());
+}
+
+void TouchFilter::predicted(int16_t& x, int16_t& y) const {
+    float horizon_s = profile_.predict_us * 1e-6f;
+    float dx = x_.velocity() * horizon_s;
+    float dy = y_.velocity() * horizon_s;
+
+    // Scale the step down as a whole so the direction is kept
+    float distance = sqrtf(dx * dx + dy * dy);
+    if (distance > profile_.predict_max_px && distance > 0) {
+        float scale = profile_.predict_max_px / distance;
+        dx *= scale;
+        dy *= scale;
+    }
+    x = (int16_t)lroundf(x_.value() + dx);
+    y = (int16_t)lroundf(y_.value() + dy);
+}
@@ -0,0 +1,78 @@
+// src/frontend_ui/touch_filter.h
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Tuning for one kind of widget.
+ *
+ * The 1€ filter lowers its smoothing as the finger speeds up: min_cutoff_hz
+ * sets how still a resting finger looks, beta how quickly fast moves stop lagging.
+ * Prediction then extrapolates along the filtered velocity to hide the time
+ * between the sample and the frame it ends up in.
+ */
+struct TouchFilterProfile {
+    float    min_cutoff_hz;   // Lower = less jitter at rest, more lag
+    float    beta;            // Higher = less lag when moving fast
+    float    d_cutoff_hz;     // Smoothing of the velocity estimate
+    uint32_t predict_us;      // Extrapolation horizon, 0 = none
+    int16_t  predict_max_px;  // Never extrapolate further than this
+};
+
+// Buttons and screens: only take the edge off the noise
+constexpr TouchFilterProfile TOUCH_PROFILE_DEFAULT = {5.0f, 0.02f, 1.0f, 0, 0};
+// Sliders and arcs: steady while resting on a value, predicted while dragging
+constexpr TouchFilterProfile TOUCH_PROFILE_DRAG = {1.0f, 0.05f, 1.0f, 20000, 24};
+
+/**
+ * @brief One axis of a 1€ filter (Casiez et al.).
+ */
+class OneEuroFilter {
+public:
+    void reset(float value);
+    float filter(float value, float dt_s, const TouchFilterProfile& profile);
+    float value() const { return value_; }
+    float velocity() const { return velocity_; } // Units per second, filtered
+
+private:
+    float value_ = 0;
+    float velocity_ = 0;
+};
+
+/**
+ * @brief Filters a stream of touch points and predicts where the finger is now.
+ *        Constant time per sample; depends only on its inputs.
+ */
+class TouchFilter {
+public:
+    void set_profile(const TouchFilterProfile& profile) { profile_ = profile; }
+
+    /**
+     * @brief Starts a new stroke at the given point, with no smoothing history.
+     */
+    void begin(int16_t x, int16_t y, uint32_t time_us);
+
+    /**
+     * @brief Feeds the next sample of the stroke.
+     */
+    void update(int16_t x, int16_t y, uint32_t time_us);
+
+    /**
+     * @brief The filtered position, extrapolated to the profile's horizon.
+     */
+    void predicted(int16_t& x, int16_t& y) const;
+
+    /**
+     * @brief The filtered position without prediction, e.g. for the final release point.
+     */
+    void filtered(int16_t& x, int16_t& y) const;
+
+private:
+    TouchFilterProfile profile_ = TOUCH_PROFILE_DEFAULT;
+    OneEuroFilter x_, y_;
+    uint32_t last_us_ = 0;
+};
+
+#endif // TOUCH_FILTER_H
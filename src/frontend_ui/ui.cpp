@@ -1,29 +1,49 @@
 #include "ui.h"
-
-LV_FONT_DECLARE(delius20_numbers);
-
-void ui_Screen1_screen_init(void);
-void ui_Screen2_screen_init(void);
-
-void publish_elapsed_time(uint16_t elapsed);
-
-static void arc_event_cb(lv_event_t * e) {
-    lv_obj_t * arc = (lv_obj_t *)lv_event_get_target(e);
-    encoderValue = lv_arc_get_value(arc);
-    lv_label_set_text_fmt(ui_value_label, "%d", (int)encoderValue);
-}
-
-static void switch_event_cb(lv_event_t * e) {
-    lv_obj_t * sw = (lv_obj_t *)lv_event_get_target(e);
-    ledsOn = lv_obj_has_state(sw, LV_STATE_CHECKED);
+#include "mqtt.h"
+#include "playback.h"
+#include "lvgl_handler.h"
+#include "effects.h"
+#include "app_state.h"
+#include "ui_styles.h"
+#include "screens.h"
+
+lv_obj_t* ui_Screen1_screen_init(void);
+lv_obj_t* ui_Screen2_screen_init(void);
+
+// Display stays alive: the playback timer and the album art download write to its widgets
+static const ScreenDef UI_SCREENS[(size_t)ScreenId::Count] = {
+    {ui_Screen1_screen_init, true},  // Display
+    {ui_Screen2_screen_init, false}, // Controls
+};
+
+/**
+ * @brief New mode: its name, and the arc range. The arc gets the (clamped) value
+ *        again because changing the range may have cut it off.
+ */
+static void mode_observer_cb(lv_observer_t * observer, lv_subject_t * subject) {
+    int mode = lv_subject_get_int(subject);
+    lv_label_set_text_static(ui_mode_label, modeNames[mode]);
+    lv_arc_set_range(ui_arc, 0, led_mode(mode).max_value);
+    lv_arc_set_value(ui_arc, app_state_value());
 }
 
 static void event_go_to_screen2(lv_event_t * e) {
-    lv_screen_load(ui_Screen2);
+    screens_push(ScreenId::Controls);
 }
 
 static void event_go_to_screen1(lv_event_t * e) {
-    lv_screen_load(ui_Screen1);
+    screens_pop();
+}
+
+/**
+ * @brief The screen manager freed the Controls screen: nothing may keep pointing into it.
+ */
+static void controls_deleted_cb(lv_event_t * e) {
+    ui_Screen2 = nullptr;
+    ui_arc = nullptr;
+    ui_value_label = nullptr;
+    ui_mode_label = nullptr;
+    ui_power_switch = nullptr;
 }
 
 static void progress_bar_event_cb(lv_event_t * e) {
@@ -32,58 +52,51 @@ static void progress_bar_event_cb(lv_event_t * e) {
 
     // Reagiere nur, wenn der Wert sich geändert hat
     if (code == LV_EVENT_VALUE_CHANGED) {
-        int32_t value = lv_slider_get_value(slider);
+        int32_t value = lv_slider_get_value(slider) / PLAYBACK_SLIDER_STEPS_PER_SECOND;
         
         // Rufe hier deine MQTT-Funktion auf, um die neue Position zu senden
         publish_elapsed_time(value); 
+    } else if (code == LV_EVENT_RELEASED) {
+        // Finger lifted: deliver the final position now instead of waiting for the rate limit
+        mqtt_flush(PublishSlot::Position);
+        playback_seek(lv_slider_get_value(slider) / PLAYBACK_SLIDER_STEPS_PER_SECOND);
     }
 }
 
 
 // --- SCREEN 1 INITIALIZATION (Display Screen) ---
 // This screen shows information but has no main controls.
-void ui_Screen1_screen_init(void) {
+lv_obj_t* ui_Screen1_screen_init(void) {
     ui_Screen1 = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(ui_Screen1, lv_color_hex(0x111111), LV_PART_MAIN);
+    lv_obj_add_style(ui_Screen1, &ui_style_screen_display, LV_PART_MAIN);
 
     ui_album_art = lv_image_create(ui_Screen1);
     lv_obj_set_size(ui_album_art, 480, 320);
     lv_obj_align(ui_album_art, LV_ALIGN_CENTER, 0, 0);
 
     ui_length_label = lv_label_create(ui_Screen1);
-    lv_obj_set_style_text_font(ui_length_label, &delius20_numbers, 0);
-    lv_obj_set_style_text_color(ui_length_label, lv_color_hex(0xD2D2D2), 0);
+    lv_obj_add_style(ui_length_label, &ui_style_time_label, LV_PART_MAIN);
     lv_obj_set_width(ui_length_label, 85);
     lv_obj_align(ui_length_label, LV_ALIGN_BOTTOM_RIGHT, -2, -25);
-    lv_obj_set_style_text_align(ui_length_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_label_set_text(ui_length_label, "0:00");
 
     ui_position_label = lv_label_create(ui_Screen1);
-    lv_obj_set_style_text_font(ui_position_label, &delius20_numbers, 0);
-    lv_obj_set_style_text_color(ui_position_label, lv_color_hex(0xD2D2D2), 0);
+    lv_obj_add_style(ui_position_label, &ui_style_time_label, LV_PART_MAIN);
     lv_obj_set_width(ui_position_label, 85);
     lv_obj_align(ui_position_label, LV_ALIGN_BOTTOM_LEFT, 2, -25);
-    lv_obj_set_style_text_align(ui_position_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_label_set_text(ui_position_label, "0:00");
 
     ui_progress_bar = lv_slider_create(ui_Screen1);
     lv_obj_align(ui_progress_bar, LV_ALIGN_BOTTOM_MID, 0, -22);
     lv_obj_set_size(ui_progress_bar, 300, 20);
-    lv_slider_set_range(ui_progress_bar, 0, 204); // Temporary max; will be updated via MQTT
-    lv_slider_set_value(ui_progress_bar, 107, LV_ANIM_ON); // Temporary value; will be updated via MQTT
-    // bg part
-    lv_obj_set_style_bg_color(ui_progress_bar, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_progress_bar, 77, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_progress_bar, lv_color_hex(0x313131), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_progress_bar, 220, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(ui_progress_bar, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-    // indicator part
-    lv_obj_set_style_bg_color(ui_progress_bar, lv_color_hex(0xFFFFFF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_progress_bar, 255, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    // Knob part
-    lv_obj_set_style_bg_color(ui_progress_bar, lv_color_hex(0xE5E5E5), LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_progress_bar, 255, LV_PART_KNOB | LV_STATE_DEFAULT);
+    lv_slider_set_range(ui_progress_bar, 0, 1); // Set from the playback clock once music status arrives
+    lv_slider_set_value(ui_progress_bar, 0, LV_ANIM_OFF);
+    lv_obj_add_style(ui_progress_bar, &ui_style_progress_main, LV_PART_MAIN);
+    lv_obj_add_style(ui_progress_bar, &ui_style_progress_indicator, LV_PART_INDICATOR);
+    lv_obj_add_style(ui_progress_bar, &ui_style_progress_knob, LV_PART_KNOB);
     lv_obj_add_event_cb(ui_progress_bar, progress_bar_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(ui_progress_bar, progress_bar_event_cb, LV_EVENT_RELEASED, NULL);
+    lvgl_set_touch_profile(ui_progress_bar, &TOUCH_PROFILE_DRAG);
 
     // Button to navigate to the Controls screen
     lv_obj_t * screen2_btn = lv_button_create(ui_Screen1);
@@ -92,39 +105,38 @@ void ui_Screen1_screen_init(void) {
     lv_obj_t * btn_label = lv_label_create(screen2_btn);
     lv_label_set_text(btn_label, "Controls");
     lv_obj_center(btn_label);
+    return ui_Screen1;
 }
 
 // --- SCREEN 2 INITIALIZATION (Controls Screen) ---
 // This screen has all the interactive controls.
-void ui_Screen2_screen_init(void) {
+lv_obj_t* ui_Screen2_screen_init(void) {
     ui_Screen2 = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(ui_Screen2, lv_color_hex(0x331133), LV_PART_MAIN);
+    lv_obj_add_event_cb(ui_Screen2, controls_deleted_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_add_style(ui_Screen2, &ui_style_screen_controls, LV_PART_MAIN);
 
     ui_arc = lv_arc_create(ui_Screen2);
     lv_obj_set_size(ui_arc, 220, 220);
     lv_obj_align(ui_arc, LV_ALIGN_CENTER, 0, 10);
     lv_arc_set_rotation(ui_arc, 135);
     lv_arc_set_bg_angles(ui_arc, 0, 270);
-    lv_arc_set_value(ui_arc, encoderValue);
-    lv_obj_add_event_cb(ui_arc, arc_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_arc_bind_value(ui_arc, &state_value); // Both ways: dragging sets the state
     lv_group_add_obj(encoder_group, ui_arc);
+    lvgl_set_touch_profile(ui_arc, &TOUCH_PROFILE_DRAG);
 
     ui_value_label = lv_label_create(ui_Screen2);
-    lv_label_set_text_fmt(ui_value_label, "%d", (int)encoderValue);
-    lv_obj_set_style_text_font(ui_value_label, &lv_font_montserrat_40, 0);
-    lv_obj_set_style_text_color(ui_value_label, lv_color_hex(0xFFFFFF), 0);
+    lv_label_bind_text(ui_value_label, &state_value, "%d");
+    lv_obj_add_style(ui_value_label, &ui_style_value_label, LV_PART_MAIN);
     lv_obj_align_to(ui_value_label, ui_arc, LV_ALIGN_CENTER, 0, 0);
 
     ui_mode_label = lv_label_create(ui_Screen2);
-    lv_label_set_text(ui_mode_label, modeNames[currentMode]);
-    lv_obj_set_style_text_font(ui_mode_label, &lv_font_montserrat_24, 0);
-    lv_obj_set_style_text_color(ui_mode_label, lv_color_hex(0xCCCCCC), 0);
+    lv_obj_add_style(ui_mode_label, &ui_style_mode_label, LV_PART_MAIN);
     lv_obj_align(ui_mode_label, LV_ALIGN_TOP_MID, 0, 15);
+    lv_subject_add_observer_obj(&state_mode, mode_observer_cb, ui_mode_label, NULL);
 
     ui_power_switch = lv_switch_create(ui_Screen2);
-    if (ledsOn) lv_obj_add_state(ui_power_switch, LV_STATE_CHECKED);
+    lv_obj_bind_checked(ui_power_switch, &state_leds_on);
     lv_obj_align(ui_power_switch, LV_ALIGN_BOTTOM_MID, 0, -20);
-    lv_obj_add_event_cb(ui_power_switch, switch_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
     lv_obj_t* power_label = lv_label_create(ui_Screen2);
     lv_label_set_text(power_label, "LEDs On");
     lv_obj_align_to(power_label, ui_power_switch, LV_ALIGN_OUT_LEFT_MID, -10, 0);
@@ -137,40 +149,93 @@ void ui_Screen2_screen_init(void) {
     lv_obj_t * btn_label = lv_label_create(screen1_btn);
     lv_label_set_text(btn_label, "Back");
     lv_obj_center(btn_label);
+    return ui_Screen2;
 }
 
 
-// --- MAIN UI INITIALIZATION ---
-void ui_init() {
-    ui_Screen1_screen_init();
-    ui_Screen2_screen_init();
-    lv_screen_load(ui_Screen1);
+#ifdef DEBUG_UI_STYLES
+LV_FONT_DECLARE(delius20_numbers);
+
+constexpr int STYLE_PROBE_COPIES = 10;
+constexpr int STYLE_PROBE_LOOKUPS = 1000;
+
+struct StyleProbe {
+    lv_obj_t* label;
+    lv_obj_t* slider;
+};
+
+/**
+ * @brief A time label and a progress bar, styled either the old way (local
+ *        styles copied into each object) or by reference to the shared pool.
+ */
+static StyleProbe create_style_probe(lv_obj_t* parent, bool shared) {
+    StyleProbe probe;
+    probe.label = lv_label_create(parent);
+    lv_label_set_text_static(probe.label, "0:00");
+    probe.slider = lv_slider_create(parent);
+
+    if (shared) {
+        lv_obj_add_style(probe.label, &ui_style_time_label, LV_PART_MAIN);
+        lv_obj_add_style(probe.slider, &ui_style_progress_main, LV_PART_MAIN);
+        lv_obj_add_style(probe.slider, &ui_style_progress_indicator, LV_PART_INDICATOR);
+        lv_obj_add_style(probe.slider, &ui_style_progress_knob, LV_PART_KNOB);
+        return probe;
+    }
+    lv_obj_set_style_text_font(probe.label, &delius20_numbers, 0);
+    lv_obj_set_style_text_color(probe.label, lv_color_hex(0xD2D2D2), 0);
+    lv_obj_set_style_text_align(probe.label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_bg_color(probe.slider, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(probe.slider, 77, LV_PART_MAIN);
+    lv_obj_set_style_border_color(probe.slider, lv_color_hex(0x313131), LV_PART_MAIN);
+    lv_obj_set_style_border_opa(probe.slider, 220, LV_PART_MAIN);
+    lv_obj_set_style_border_width(probe.slider, 2, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(probe.slider, lv_color_hex(0xFFFFFF), LV_PART_INDICATOR);
+    lv_obj_set_style_bg_opa(probe.slider, LV_OPA_COVER, LV_PART_INDICATOR);
+    lv_obj_set_style_bg_color(probe.slider, lv_color_hex(0xE5E5E5), LV_PART_KNOB);
+    lv_obj_set_style_bg_opa(probe.slider, LV_OPA_COVER, LV_PART_KNOB);
+    return probe;
 }
 
-// --- UI STATE SYNC ---
-void sync_ui_with_state() {
-    // KEY CHANGE: Check which screen is active before updating widgets.
-
-    if (lv_screen_active() == ui_Screen1) {
-        // This is the "Display" screen.
-        // You can add logic here to update the album art or time labels if needed.
-        // For example: lv_label_set_text(ui_position_label, new_time_string);
-    } 
-    else if (lv_screen_active() == ui_Screen2) {
-        // This is the "Controls" screen. Only update the controls when this screen is visible.
-        if (lv_arc_get_value(ui_arc) != encoderValue) {
-            lv_arc_set_value(ui_arc, encoderValue);
-            lv_label_set_text_fmt(ui_value_label, "%d", (int)encoderValue);
+/**
+ * @brief Logs heap per widget pair and style lookup time for both ways of
+ *        styling, so one boot gives the before and after side by side. The
+ *        probes live on a screen that is never loaded and are deleted again.
+ *        Boot once more built with -D LV_OBJ_STYLE_CACHE=0 for the cache's share.
+ */
+static void measure_styles() {
+    for (int shared = 0; shared <= 1; shared++) {
+        lv_obj_t* screen = lv_obj_create(NULL);
+        StyleProbe probe = {};
+        size_t heap_before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        for (int i = 0; i < STYLE_PROBE_COPIES; i++) {
+            probe = create_style_probe(screen, shared);
         }
-        if (ledsOn && !lv_obj_has_state(ui_power_switch, LV_STATE_CHECKED)) {
-            lv_obj_add_state(ui_power_switch, LV_STATE_CHECKED);
-        } else if (!ledsOn && lv_obj_has_state(ui_power_switch, LV_STATE_CHECKED)) {
-            lv_obj_clear_state(ui_power_switch, LV_STATE_CHECKED);
+        size_t heap_used = heap_before - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+
+        // Set on the object, set on a part, and set nowhere (the default)
+        uint32_t start = micros();
+        for (int i = 0; i < STYLE_PROBE_LOOKUPS; i++) {
+            lv_obj_get_style_text_font(probe.label, LV_PART_MAIN);
+            lv_obj_get_style_bg_opa(probe.slider, LV_PART_KNOB);
+            lv_obj_get_style_shadow_width(probe.slider, LV_PART_MAIN);
         }
-        lv_label_set_text(ui_mode_label, modeNames[currentMode]);
-        if (currentMode == 0) lv_arc_set_range(ui_arc, 0, 100);
-        if (currentMode == 1) lv_arc_set_range(ui_arc, 0, 255);
-        if (currentMode == 2) lv_arc_set_range(ui_arc, 0, HW::NUM_LEDS - 1);
-        if (currentMode == 3) lv_arc_set_range(ui_arc, 0, 100); // Volume 0-100%
+        uint32_t lookup_us = micros() - start;
+
+        Serial.printf("[UI] %s styles, style cache %s: %u bytes of heap per label + slider, %u ns per style lookup\n",
+                      shared ? "Shared" : "Local", LV_OBJ_STYLE_CACHE ? "on" : "off",
+                      (unsigned)(heap_used / STYLE_PROBE_COPIES),
+                      (unsigned)((uint64_t)lookup_us * 1000 / (3 * STYLE_PROBE_LOOKUPS)));
+        lv_obj_delete(screen);
     }
-}
\ No newline at end of file
+}
+#endif
+
+// --- MAIN UI INITIALIZATION ---
+void ui_init() {
+    ui_styles_init();
+    screens_init(UI_SCREENS, ScreenId::Display); // Controls is built on first visit
+
+    #ifdef DEBUG_UI_STYLES
+        measure_styles();
+    #endif
+}
@@ -0,0 +1,55 @@
+// src/frontend_ui/ui_styles.cpp
+
+#include "ui_styles.h"
+
+LV_FONT_DECLARE(delius20_numbers);
+
+// --- Styles ---
+lv_style_t ui_style_screen_display;
+lv_style_t ui_style_screen_controls;
+lv_style_t ui_style_time_label;
+lv_style_t ui_style_progress_main;
+lv_style_t ui_style_progress_indicator;
+lv_style_t ui_style_progress_knob;
+lv_style_t ui_style_value_label;
+lv_style_t ui_style_mode_label;
+
+// =========================================================================
+// PUBLIC FUNCTIONS (as defined in ui_styles.h)
+// =========================================================================
+
+void ui_styles_init() {
+    lv_style_init(&ui_style_screen_display);
+    lv_style_set_bg_color(&ui_style_screen_display, lv_color_hex(0x111111));
+
+    lv_style_init(&ui_style_screen_controls);
+    lv_style_set_bg_color(&ui_style_screen_controls, lv_color_hex(0x331133));
+
+    lv_style_init(&ui_style_time_label);
+    lv_style_set_text_font(&ui_style_time_label, &delius20_numbers);
+    lv_style_set_text_color(&ui_style_time_label, lv_color_hex(0xD2D2D2));
+    lv_style_set_text_align(&ui_style_time_label, LV_TEXT_ALIGN_CENTER);
+
+    lv_style_init(&ui_style_progress_main);
+    lv_style_set_bg_color(&ui_style_progress_main, lv_color_hex(0xFFFFFF));
+    lv_style_set_bg_opa(&ui_style_progress_main, 77);
+    lv_style_set_border_color(&ui_style_progress_main, lv_color_hex(0x313131));
+    lv_style_set_border_opa(&ui_style_progress_main, 220);
+    lv_style_set_border_width(&ui_style_progress_main, 2);
+
+    lv_style_init(&ui_style_progress_indicator);
+    lv_style_set_bg_color(&ui_style_progress_indicator, lv_color_hex(0xFFFFFF));
+    lv_style_set_bg_opa(&ui_style_progress_indicator, LV_OPA_COVER);
+
+    lv_style_init(&ui_style_progress_knob);
+    lv_style_set_bg_color(&ui_style_progress_knob, lv_color_hex(0xE5E5E5));
+    lv_style_set_bg_opa(&ui_style_progress_knob, LV_OPA_COVER);
+
+    lv_style_init(&ui_style_value_label);
+    lv_style_set_text_font(&ui_style_value_label, &lv_font_montserrat_40);
+    lv_style_set_text_color(&ui_style_value_label, lv_color_hex(0xFFFFFF));
+
+    lv_style_init(&ui_style_mode_label);
+    lv_style_set_text_font(&ui_style_mode_label, &lv_font_montserrat_24);
+    lv_style_set_text_color(&ui_style_mode_label, lv_color_hex(0xCCCCCC));
+}
@@ -0,0 +1,30 @@
+// src/frontend_ui/ui_styles.h
+
+#ifndef UI_STYLES_H
+#define UI_STYLES_H
+
+#include <lvgl.h>
+
+// =========================================================================
+// SHARED STYLES
+// Every widget look is defined once here and added by reference with
+// lv_obj_add_style(). An object then holds one 8-byte pointer per style
+// instead of its own heap copy of every property. Keep per-object local
+// styles (lv_obj_set_style_*) for geometry only.
+// =========================================================================
+
+extern lv_style_t ui_style_screen_display;   // Screen 1 background
+extern lv_style_t ui_style_screen_controls;  // Screen 2 background
+extern lv_style_t ui_style_time_label;       // Position and length labels
+extern lv_style_t ui_style_progress_main;    // Slider track
+extern lv_style_t ui_style_progress_indicator;
+extern lv_style_t ui_style_progress_knob;
+extern lv_style_t ui_style_value_label;      // Big number in the arc
+extern lv_style_t ui_style_mode_label;
+
+/**
+ * @brief Fills in the shared styles. Call once after lvgl_init(), before creating widgets.
+ */
+void ui_styles_init();
+
+#endif // UI_STYLES_H
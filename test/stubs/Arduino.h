@@ -0,0 +1,83 @@
+// test/stubs/Arduino.h
+
+#ifndef ARDUINO_STUB_H
+#define ARDUINO_STUB_H
+
+// =========================================================================
+// ARDUINO STAND-IN FOR THE NATIVE TESTS
+// Only what the host-built modules use. Anything touching hardware stays
+// out of the native build instead of being stubbed here.
+// =========================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+/**
+ * @brief Serial output goes to stdout, where the test runner shows it.
+ */
+struct HostSerial {
+    int printf(const char* format, ...) {
+        if (muted) return 0;
+        va_list args;
+        va_start(args, format);
+        int written = vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+    void println(const char* text) {
+        if (!muted) ::printf("%s\n", text);
+    }
+
+    bool muted = false; // Lets replay tests run thousands of messages without the logs
+};
+
+inline HostSerial Serial;
+
+/**
+ * @brief Time since the first call, from the host's monotonic clock.
+ */
+inline uint32_t micros() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline uint32_t millis() {
+    return micros() / 1000;
+}
+
+// The host has no PSRAM; the ordinary heap stands in for it
+inline void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+/**
+ * @brief The byte-sink half of Arduino's Print/Stream, as PubSubClient uses it.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t byte) = 0;
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+#endif // ARDUINO_STUB_H
@@ -0,0 +1,67 @@
+// test/stubs/FastLED.h
+
+#ifndef FASTLED_STUB_H
+#define FASTLED_STUB_H
+
+// =========================================================================
+// FASTLED STAND-IN FOR THE NATIVE TESTS
+// The colour types and the few helpers effects.cpp uses. hsv2rgb follows
+// FastLED's integer approach (six hue sections, 8-bit math), so effect
+// timings stay comparable; colours may differ from FastLED's by a few steps.
+// =========================================================================
+
+#include <stdint.h>
+
+struct CHSV {
+    uint8_t h, s, v;
+
+    CHSV() : h(0), s(0), v(0) {}
+    CHSV(uint8_t hue, uint8_t sat, uint8_t val) : h(hue), s(sat), v(val) {}
+};
+
+struct CRGB {
+    uint8_t r, g, b;
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue  = 0x0000FF,
+        Red   = 0xFF0000,
+        Wheat = 0xF5DEB3,
+        White = 0xFFFFFF,
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(HTMLColorCode code) : r(code >> 16), g(code >> 8), b(code) {}
+    CRGB(const CHSV& hsv) { *this = hsv; }
+
+    CRGB& operator=(const CHSV& hsv) {
+        // Six 43-step sections around the wheel, then desaturate and scale
+        uint8_t section = hsv.h / 43;
+        uint8_t ramp = (hsv.h - section * 43) * 6;
+        uint8_t up = ramp, down = 255 - ramp;
+        uint8_t red, green, blue;
+        switch (section) {
+            case 0:  red = 255;  green = up;   blue = 0;    break;
+            case 1:  red = down; green = 255;  blue = 0;    break;
+            case 2:  red = 0;    green = 255;  blue = up;   break;
+            case 3:  red = 0;    green = down; blue = 255;  break;
+            case 4:  red = up;   green = 0;    blue = 255;  break;
+            default: red = 255;  green = 0;    blue = down; break;
+        }
+        uint8_t white = 255 - hsv.s;
+        r = (uint16_t)(white + ((uint16_t)red * hsv.s >> 8)) * hsv.v >> 8;
+        g = (uint16_t)(white + ((uint16_t)green * hsv.s >> 8)) * hsv.v >> 8;
+        b = (uint16_t)(white + ((uint16_t)blue * hsv.s >> 8)) * hsv.v >> 8;
+        return *this;
+    }
+
+    bool operator==(const CRGB& other) const { return r == other.r && g == other.g && b == other.b; }
+    bool operator!=(const CRGB& other) const { return !(*this == other); }
+};
+
+inline void fill_solid(CRGB* leds, int count, const CRGB& color) {
+    for (int i = 0; i < count; i++) leds[i] = color;
+}
+
+#endif // FASTLED_STUB_H
@@ -0,0 +1,67 @@
+// test/stubs/PubSubClient.h
+
+#ifndef PUBSUBCLIENT_STUB_H
+#define PUBSUBCLIENT_STUB_H
+
+// =========================================================================
+// PUBSUBCLIENT STAND-IN FOR THE NATIVE TESTS
+// No socket: deliver() plays the part of loop() receiving one PUBLISH. It
+// feeds the payload to the attached stream byte by byte and keeps what fits
+// of it in the client buffer, then calls the callback the way
+// PubSubClient 2.8 does.
+// =========================================================================
+
+#include <Arduino.h>
+
+#define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
+
+class PubSubClient {
+public:
+    PubSubClient() { setBufferSize(256); }
+    ~PubSubClient() { free(buffer_); }
+
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE) {
+        callback_ = callback;
+        return *this;
+    }
+
+    PubSubClient& setStream(Stream& stream) {
+        stream_ = &stream;
+        return *this;
+    }
+
+    bool setBufferSize(uint16_t size) {
+        uint8_t* grown = (uint8_t*)realloc(buffer_, size);
+        if (!grown) return false;
+        buffer_ = grown;
+        buffer_size_ = size;
+        return true;
+    }
+
+    /**
+     * @brief Receives one PUBLISH on topic. Returns false if the topic doesn't
+     *        fit the buffer, which PubSubClient would drop as well.
+     */
+    bool deliver(const char* topic, const uint8_t* payload, unsigned int length) {
+        size_t topic_length = strlen(topic);
+        if (topic_length + 1 > buffer_size_) return false;
+        memcpy(buffer_, topic, topic_length + 1);
+
+        uint8_t* kept = buffer_ + topic_length + 1;
+        size_t room = buffer_size_ - topic_length - 1;
+        for (unsigned int i = 0; i < length; i++) {
+            if (stream_) stream_->write(payload[i]);
+            if (i < room) kept[i] = payload[i];
+        }
+        if (callback_) callback_((char*)buffer_, kept, length);
+        return true;
+    }
+
+private:
+    void (*callback_)(char*, uint8_t*, unsigned int) = nullptr;
+    Stream* stream_ = nullptr;
+    uint8_t* buffer_ = nullptr;
+    uint16_t buffer_size_ = 0;
+};
+
+#endif // PUBSUBCLIENT_STUB_H
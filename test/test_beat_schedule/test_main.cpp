@@ -0,0 +1,206 @@
+// test/test_beat_schedule/test_main.cpp
+
+#include <unity.h>
+#include <vector>
+#include "beat_schedule.h"
+
+constexpr uint32_t MAX_LATE_US = 50000; // beats.cpp's settings
+constexpr uint64_t SEEK_US = 250000;
+
+static BeatSchedule schedule;
+static LatencyHistogram lateness;
+
+void setUp(void) {
+    schedule = BeatSchedule();
+    lateness.reset();
+}
+
+void tearDown(void) {}
+
+// =========================================================================
+// HELPERS
+// =========================================================================
+
+/**
+ * @brief Encodes a schedule the way the bridge does: gaps from rounded absolute times.
+ */
+static std::vector<uint8_t> encode(uint32_t start_ms, uint16_t count, uint16_t bpm, uint8_t beats_per_bar) {
+    std::vector<uint8_t> out = {BEAT_SCHEDULE_VERSION, 0, (uint8_t)count, (uint8_t)(count >> 8),
+                                (uint8_t)start_ms, (uint8_t)(start_ms >> 8), (uint8_t)(start_ms >> 16), (uint8_t)(start_ms >> 24)};
+    uint32_t previous = start_ms;
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t beat = start_ms + (uint32_t)((uint64_t)(i + 1) * 60000 / bpm);
+        uint16_t entry = (beat - previous) | (i % beats_per_bar == 0 ? 0x8000 : 0);
+        out.push_back(entry);
+        out.push_back(entry >> 8);
+        previous = beat;
+    }
+    return out;
+}
+
+static void load(uint32_t start_ms, uint16_t count, uint16_t bpm, uint8_t beats_per_bar = 4) {
+    std::vector<uint8_t> payload = encode(start_ms, count, bpm, beats_per_bar);
+    TEST_ASSERT_EQUAL((int)BeatDecodeResult::Ok, (int)beat_schedule_decode(payload.data(), payload.size(), schedule));
+}
+
+// =========================================================================
+// DECODE
+// =========================================================================
+
+void test_decode_accumulates_gaps_and_downbeats() {
+    load(10000, 8, 120); // A beat every 500 ms
+    TEST_ASSERT_EQUAL(8, schedule.count);
+    for (uint16_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_UINT32(10000 + (i + 1) * 500, schedule.beat_ms[i]);
+        TEST_ASSERT_EQUAL(i % 4 == 0, schedule.is_downbeat(i));
+    }
+}
+
+void test_decode_does_not_drift_on_odd_tempos() {
+    load(0, 256, 133);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(256ull * 60000 / 133), schedule.beat_ms[255]);
+}
+
+void test_decode_keeps_the_first_max_beats() {
+    load(0, BEAT_SCHEDULE_MAX + 44, 240);
+    TEST_ASSERT_EQUAL(BEAT_SCHEDULE_MAX, schedule.count);
+    TEST_ASSERT_EQUAL_UINT32(BEAT_SCHEDULE_MAX * 250, schedule.beat_ms[BEAT_SCHEDULE_MAX - 1]);
+}
+
+void test_decode_rejects_bad_payloads() {
+    std::vector<uint8_t> payload = encode(0, 4, 120, 4);
+    TEST_ASSERT_EQUAL((int)BeatDecodeResult::BadHeader, (int)beat_schedule_decode(payload.data(), 7, schedule));
+    TEST_ASSERT_EQUAL((int)BeatDecodeResult::Truncated, (int)beat_schedule_decode(payload.data(), payload.size() - 1, schedule));
+    payload[0] = BEAT_SCHEDULE_VERSION + 1;
+    TEST_ASSERT_EQUAL((int)BeatDecodeResult::BadHeader, (int)beat_schedule_decode(payload.data(), payload.size(), schedule));
+}
+
+// =========================================================================
+// PLAYBACK
+// =========================================================================
+
+void test_fires_each_beat_once_as_it_comes_due() {
+    load(0, 16, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    uint32_t fired = 0;
+    for (uint64_t position = 0; position <= 8000000; position += 4000) { // A 4 ms LED frame
+        BeatStep step = cursor.advance(schedule, position, lateness);
+        fired += step.fired;
+        TEST_ASSERT_EQUAL(0, step.skipped);
+        if (step.fired) TEST_ASSERT_LESS_THAN(4000, step.late_us);
+    }
+    TEST_ASSERT_EQUAL_UINT32(16, fired);
+    TEST_ASSERT_EQUAL_UINT32(16, lateness.count());
+}
+
+void test_reports_the_wait_to_the_next_beat() {
+    load(0, 4, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    TEST_ASSERT_EQUAL_UINT32(500000, cursor.advance(schedule, 0, lateness).wait_us);
+    TEST_ASSERT_EQUAL_UINT32(100000, cursor.advance(schedule, 400000, lateness).wait_us);
+
+    BeatStep step = cursor.advance(schedule, 510000, lateness);
+    TEST_ASSERT_EQUAL(1, step.fired);
+    TEST_ASSERT_EQUAL_UINT32(10000, step.late_us);
+    TEST_ASSERT_TRUE(step.downbeat);
+    TEST_ASSERT_EQUAL_UINT32(490000, step.wait_us);
+
+    TEST_ASSERT_EQUAL_UINT32(BEAT_NONE, cursor.advance(schedule, 2000000, lateness).wait_us);
+}
+
+void test_late_beats_are_skipped() {
+    load(0, 4, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    cursor.advance(schedule, 400000, lateness);
+    BeatStep step = cursor.advance(schedule, 560000, lateness); // A 160 ms stall
+    TEST_ASSERT_EQUAL(0, step.fired);
+    TEST_ASSERT_EQUAL(1, step.skipped);
+    TEST_ASSERT_EQUAL_UINT32(0, lateness.count());
+}
+
+// =========================================================================
+// SEEK
+// =========================================================================
+
+void test_seek_forward_fires_nothing_in_between() {
+    load(0, 64, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    cursor.advance(schedule, 1000, lateness);
+    BeatStep step = cursor.advance(schedule, 20100000, lateness); // Jump to 20.1 s
+    TEST_ASSERT_EQUAL(0, step.fired);
+    TEST_ASSERT_EQUAL(0, step.skipped);
+    TEST_ASSERT_EQUAL(40, cursor.next_beat()); // The beat at 20.5 s
+    TEST_ASSERT_EQUAL_UINT32(400000, step.wait_us);
+}
+
+void test_seek_back_replays_from_there() {
+    load(0, 64, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    cursor.advance(schedule, 20000000, lateness);
+    cursor.advance(schedule, 2900000, lateness);
+    TEST_ASSERT_EQUAL(5, cursor.next_beat()); // The beat at 3 s
+    BeatStep step = cursor.advance(schedule, 3002000, lateness);
+    TEST_ASSERT_EQUAL(1, step.fired);
+}
+
+void test_small_jumps_are_not_seeks() {
+    // A clock correction of 100 ms forward still fires the beat it passes
+    load(0, 8, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    cursor.advance(schedule, 480000, lateness);
+    BeatStep step = cursor.advance(schedule, 540000, lateness);
+    TEST_ASSERT_EQUAL(1, step.fired);
+}
+
+void test_seek_lands_where_a_linear_scan_does() {
+    load(0, BEAT_SCHEDULE_MAX, 137);
+    uint32_t rng = 7;
+    for (int i = 0; i < 2000; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        uint64_t position = (uint64_t)(rng % 120000) * 1000 + rng % 1000;
+        if (i % 10 == 0) position = schedule.beat_us(rng % schedule.count); // Exactly on a beat
+
+        BeatCursor cursor(MAX_LATE_US, SEEK_US);
+        cursor.advance(schedule, position, lateness);
+        uint16_t expected = 0;
+        while (expected < schedule.count && schedule.beat_us(expected) < position) expected++;
+        // On a beat, that beat fires at once and the cursor moves past it
+        if (expected < schedule.count && schedule.beat_us(expected) == position) expected++;
+        TEST_ASSERT_EQUAL(expected, cursor.next_beat());
+    }
+}
+
+void test_resync_seeks_on_the_next_advance() {
+    load(0, 16, 120);
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    cursor.advance(schedule, 900000, lateness);
+    cursor.resync(); // e.g. playback paused and resumed 200 ms further on
+    BeatStep step = cursor.advance(schedule, 1100000, lateness); // Passed the beat at 1 s
+    TEST_ASSERT_EQUAL(0, step.fired + step.skipped);
+    TEST_ASSERT_EQUAL(2, cursor.next_beat()); // The beat at 1.5 s
+}
+
+void test_empty_schedule_waits_forever() {
+    BeatCursor cursor(MAX_LATE_US, SEEK_US);
+    BeatStep step = cursor.advance(schedule, 5000000, lateness);
+    TEST_ASSERT_EQUAL(0, step.fired);
+    TEST_ASSERT_EQUAL_UINT32(BEAT_NONE, step.wait_us);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_accumulates_gaps_and_downbeats);
+    RUN_TEST(test_decode_does_not_drift_on_odd_tempos);
+    RUN_TEST(test_decode_keeps_the_first_max_beats);
+    RUN_TEST(test_decode_rejects_bad_payloads);
+    RUN_TEST(test_fires_each_beat_once_as_it_comes_due);
+    RUN_TEST(test_reports_the_wait_to_the_next_beat);
+    RUN_TEST(test_late_beats_are_skipped);
+    RUN_TEST(test_seek_forward_fires_nothing_in_between);
+    RUN_TEST(test_seek_back_replays_from_there);
+    RUN_TEST(test_small_jumps_are_not_seeks);
+    RUN_TEST(test_seek_lands_where_a_linear_scan_does);
+    RUN_TEST(test_resync_seeks_on_the_next_advance);
+    RUN_TEST(test_empty_schedule_waits_forever);
+    return UNITY_END();
+}
@@ -0,0 +1,233 @@
+// test/test_buttons/test_main.cpp
+
+#include <unity.h>
+#include <vector>
+#include "buttons.h"
+
+constexpr uint32_t TICK_US = 1000; // loop() pass
+constexpr InputButton BUTTON = BUTTON_BACK;
+
+static std::vector<ButtonEvent> log_events;
+static uint32_t now_us;
+
+static void log_button_event(const ButtonEvent& event, void* ctx) {
+    log_events.push_back(event);
+}
+
+void setUp(void) {
+    log_events.clear();
+    now_us = 1000000;
+}
+
+void tearDown(void) {}
+
+// =========================================================================
+// HELPERS
+// =========================================================================
+
+static void edge(bool down) {
+    InputEvent event = {now_us, down ? InputEventType::ButtonDown : InputEventType::ButtonUp, BUTTON};
+    buttons_feed(event);
+}
+
+/**
+ * @brief Lets time pass, ticking like loop() does.
+ */
+static void run_for(uint32_t us) {
+    for (uint32_t end = now_us + us; now_us < end;) {
+        now_us += TICK_US;
+        buttons_tick(now_us);
+    }
+}
+
+static void press_for(uint32_t us) {
+    edge(true);
+    run_for(us);
+    edge(false);
+}
+
+static std::vector<ButtonEvent> of_action(ButtonAction action) {
+    std::vector<ButtonEvent> found;
+    for (const ButtonEvent& e : log_events) {
+        if (e.action == action) found.push_back(e);
+    }
+    return found;
+}
+
+// =========================================================================
+// DEBOUNCE AND CLICK
+// =========================================================================
+
+void test_press_and_release_is_a_click() {
+    buttons_configure(BUTTON, BUTTON_CONFIG_DEFAULT);
+    uint32_t down_us = now_us;
+    press_for(80000);
+    uint32_t up_us = now_us;
+    run_for(10000);
+
+    TEST_ASSERT_EQUAL(3, log_events.size());
+    TEST_ASSERT_EQUAL((int)ButtonAction::Press, (int)log_events[0].action);
+    TEST_ASSERT_EQUAL_UINT32(down_us, log_events[0].time_us);
+    TEST_ASSERT_EQUAL((int)ButtonAction::Release, (int)log_events[1].action);
+    TEST_ASSERT_EQUAL((int)ButtonAction::Click, (int)log_events[2].action);
+    TEST_ASSERT_EQUAL_UINT32(up_us, log_events[2].time_us);
+    TEST_ASSERT_EQUAL(BUTTON, log_events[2].button);
+    TEST_ASSERT_FALSE(buttons_is_pressed(BUTTON));
+}
+
+void test_bounces_make_one_press() {
+    buttons_configure(BUTTON, BUTTON_CONFIG_DEFAULT);
+    uint32_t bounces = buttons_bounce_count();
+    edge(true);
+    for (int i = 0; i < 3; i++) {
+        now_us += 500;
+        edge(false);
+        now_us += 500;
+        edge(true);
+    }
+    run_for(50000);
+    TEST_ASSERT_TRUE(buttons_is_pressed(BUTTON));
+    edge(false);
+    now_us += 700;
+    edge(true); // Release bounce
+    now_us += 700;
+    edge(false);
+    run_for(20000);
+
+    TEST_ASSERT_EQUAL(1, of_action(ButtonAction::Press).size());
+    TEST_ASSERT_EQUAL(1, of_action(ButtonAction::Click).size());
+    TEST_ASSERT_EQUAL_UINT32(8, buttons_bounce_count() - bounces);
+}
+
+void test_bounce_settling_on_the_other_level_is_taken() {
+    // A 1 ms glitch: accepted down at once, the up edge inside the window
+    // is taken once the window has passed
+    buttons_configure(BUTTON, BUTTON_CONFIG_DEFAULT);
+    edge(true);
+    now_us += 1000;
+    uint32_t up_us = now_us;
+    edge(false);
+    run_for(10000);
+
+    std::vector<ButtonEvent> releases = of_action(ButtonAction::Release);
+    TEST_ASSERT_EQUAL(1, releases.size());
+    TEST_ASSERT_EQUAL_UINT32(up_us, releases[0].time_us);
+    TEST_ASSERT_FALSE(buttons_is_pressed(BUTTON));
+}
+
+// =========================================================================
+// DOUBLE CLICK
+// =========================================================================
+
+void test_two_quick_clicks_are_a_double_click() {
+    buttons_configure(BUTTON, {5000, 0, 300000, 0, 0});
+    press_for(60000);
+    run_for(100000);
+    press_for(60000);
+    run_for(400000);
+
+    TEST_ASSERT_EQUAL(1, of_action(ButtonAction::DoubleClick).size());
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::Click).size());
+}
+
+void test_single_click_waits_for_the_window() {
+    buttons_configure(BUTTON, {5000, 0, 300000, 0, 0});
+    press_for(60000);
+    uint32_t up_us = now_us;
+    run_for(299000);
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::Click).size());
+    run_for(2000);
+
+    std::vector<ButtonEvent> clicks = of_action(ButtonAction::Click);
+    TEST_ASSERT_EQUAL(1, clicks.size());
+    TEST_ASSERT_EQUAL_UINT32(up_us, clicks[0].time_us); // Stamped with the release
+}
+
+void test_clicks_too_far_apart_are_two_clicks() {
+    buttons_configure(BUTTON, {5000, 0, 300000, 0, 0});
+    press_for(60000);
+    run_for(350000);
+    press_for(60000);
+    run_for(350000);
+    TEST_ASSERT_EQUAL(2, of_action(ButtonAction::Click).size());
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::DoubleClick).size());
+}
+
+// =========================================================================
+// HOLD AND REPEAT
+// =========================================================================
+
+void test_hold_is_a_long_press_not_a_click() {
+    buttons_configure(BUTTON, BUTTON_CONFIG_DEFAULT);
+    uint32_t down_us = now_us;
+    press_for(1500000);
+    run_for(10000);
+
+    std::vector<ButtonEvent> holds = of_action(ButtonAction::LongPress);
+    TEST_ASSERT_EQUAL(1, holds.size());
+    TEST_ASSERT_UINT32_WITHIN(TICK_US, down_us + BUTTON_CONFIG_DEFAULT.long_press_us, holds[0].time_us);
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::Click).size());
+    TEST_ASSERT_EQUAL(1, of_action(ButtonAction::Release).size());
+}
+
+void test_disabled_long_press_never_fires() {
+    buttons_configure(BUTTON, {5000, 0, 0, 0, 0});
+    press_for(3000000);
+    run_for(10000);
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::LongPress).size());
+    TEST_ASSERT_EQUAL(1, of_action(ButtonAction::Click).size());
+}
+
+void test_repeats_start_after_the_delay_and_keep_the_interval() {
+    // The mode button's timing in hardware_init()
+    buttons_configure(BUTTON, {5000, 0, 300000, 600000, 400000});
+    uint32_t down_us = now_us;
+    press_for(1500000);
+    run_for(400000);
+
+    std::vector<ButtonEvent> repeats = of_action(ButtonAction::Repeat);
+    TEST_ASSERT_EQUAL(3, repeats.size()); // 600, 1000 and 1400 ms
+    for (size_t i = 0; i < repeats.size(); i++) {
+        TEST_ASSERT_EQUAL(i + 1, repeats[i].repeat);
+        TEST_ASSERT_UINT32_WITHIN(TICK_US, down_us + 600000 + i * 400000, repeats[i].time_us);
+    }
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::Click).size());
+    TEST_ASSERT_EQUAL(0, of_action(ButtonAction::DoubleClick).size());
+}
+
+void test_repeat_timing_does_not_drift_with_slow_ticks() {
+    // A 7 ms loop() pass: each repeat is late by at most one pass, never cumulatively
+    buttons_configure(BUTTON, {5000, 0, 0, 600000, 100000});
+    uint32_t down_us = now_us;
+    edge(true);
+    for (uint32_t end = now_us + 2000000; now_us < end;) {
+        now_us += 7000;
+        buttons_tick(now_us);
+    }
+    edge(false);
+
+    std::vector<ButtonEvent> repeats = of_action(ButtonAction::Repeat);
+    TEST_ASSERT_EQUAL(15, repeats.size());
+    for (size_t i = 0; i < repeats.size(); i++) {
+        uint32_t due = down_us + 600000 + i * 100000;
+        TEST_ASSERT_GREATER_OR_EQUAL(due, repeats[i].time_us);
+        TEST_ASSERT_LESS_THAN(due + 7000, repeats[i].time_us);
+    }
+}
+
+int main(int argc, char** argv) {
+    buttons_subscribe(log_button_event, nullptr);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_press_and_release_is_a_click);
+    RUN_TEST(test_bounces_make_one_press);
+    RUN_TEST(test_bounce_settling_on_the_other_level_is_taken);
+    RUN_TEST(test_two_quick_clicks_are_a_double_click);
+    RUN_TEST(test_single_click_waits_for_the_window);
+    RUN_TEST(test_clicks_too_far_apart_are_two_clicks);
+    RUN_TEST(test_hold_is_a_long_press_not_a_click);
+    RUN_TEST(test_disabled_long_press_never_fires);
+    RUN_TEST(test_repeats_start_after_the_delay_and_keep_the_interval);
+    RUN_TEST(test_repeat_timing_does_not_drift_with_slow_ticks);
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+// test/test_effects/test_main.cpp
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "config.h"
+#include "effects.h"
+
+constexpr int BENCH_FRAMES = 20000;
+constexpr uint32_t FRAME_MS = 1000 / HW::LED_FPS;
+
+static CRGB frame[HW::NUM_LEDS];
+
+void setUp(void) {
+    led_mode_set_beat(BeatPulse{});
+}
+
+void tearDown(void) {}
+
+static int mode_index(const char* name) {
+    for (int i = 0; i < totalModes; i++) {
+        if (strcmp(modeNames[i], name) == 0) return i;
+    }
+    TEST_FAIL_MESSAGE(name);
+    return -1;
+}
+
+static int lit_count() {
+    int lit = 0;
+    for (int i = 0; i < HW::NUM_LEDS; i++) {
+        if (frame[i] != CRGB(CRGB::Black)) lit++;
+    }
+    return lit;
+}
+
+// =========================================================================
+// REGISTRY
+// =========================================================================
+
+void test_names_follow_the_registry() {
+    TEST_ASSERT_GREATER_THAN(0, totalModes);
+    for (int i = 0; i < totalModes; i++) {
+        TEST_ASSERT_EQUAL_STRING(led_mode(i).name, modeNames[i]);
+        TEST_ASSERT_NOT_NULL(led_mode(i).render);
+    }
+    TEST_ASSERT_EQUAL_STRING(modeNames[totalModes - 1], led_mode(totalModes + 5).name); // Clamped
+}
+
+void test_out_of_range_mode_clears_the_ring() {
+    fill_solid(frame, HW::NUM_LEDS, CRGB::Red);
+    TEST_ASSERT_EQUAL(0, led_mode_render(totalModes, frame, HW::NUM_LEDS, 0, 0));
+    TEST_ASSERT_EQUAL(0, lit_count());
+}
+
+// =========================================================================
+// EFFECTS
+// =========================================================================
+
+void test_position_lights_one_led() {
+    int position = mode_index("Position");
+    led_mode_render(position, frame, HW::NUM_LEDS, 0, 3);
+    TEST_ASSERT_EQUAL(1, lit_count());
+    TEST_ASSERT_TRUE(frame[3] == CRGB(CRGB::Red));
+
+    led_mode_render(position, frame, HW::NUM_LEDS, 0, 1000); // Clamped to the last LED
+    TEST_ASSERT_TRUE(frame[HW::NUM_LEDS - 1] == CRGB(CRGB::Red));
+}
+
+void test_beat_flashes_and_decays() {
+    int beat = mode_index("Beat");
+    led_mode_render(beat, frame, HW::NUM_LEDS, 0, 0);
+    TEST_ASSERT_EQUAL(0, lit_count()); // No schedule, dark
+
+    led_mode_set_beat(BeatPulse{true, false, 0});
+    led_mode_render(beat, frame, HW::NUM_LEDS, 0, 0);
+    TEST_ASSERT_EQUAL(HW::NUM_LEDS, lit_count());
+    uint8_t fresh = frame[0].r;
+
+    led_mode_set_beat(BeatPulse{true, false, 90});
+    led_mode_render(beat, frame, HW::NUM_LEDS, 0, 0);
+    TEST_ASSERT_LESS_THAN(fresh, frame[0].r);
+
+    led_mode_set_beat(BeatPulse{true, false, 1000});
+    led_mode_render(beat, frame, HW::NUM_LEDS, 0, 0);
+    TEST_ASSERT_EQUAL(0, lit_count());
+}
+
+void test_comet_head_moves() {
+    int comet = mode_index("Comet");
+    led_mode_render(comet, frame, HW::NUM_LEDS, 0, 0);
+    CRGB first[HW::NUM_LEDS];
+    memcpy(first, frame, sizeof(frame));
+    led_mode_render(comet, frame, HW::NUM_LEDS, 500, 0);
+    TEST_ASSERT_TRUE(memcmp(first, frame, sizeof(frame)) != 0);
+    TEST_ASSERT_LESS_THAN(HW::NUM_LEDS, lit_count()); // Only the head and tail are lit
+}
+
+// =========================================================================
+// BENCHMARK
+// Every registered mode renders the whole ring at the frame rate's clock
+// steps, against HW::LED_EFFECT_BUDGET_US. The host is many times faster
+// than the ESP32-S3, so passing here only catches gross regressions; the
+// device's own figure is effect_us_max in the /led telemetry section.
+// =========================================================================
+
+void test_benchmark_every_mode_within_budget() {
+    led_mode_set_beat(BeatPulse{true, true, 20});
+    for (int mode = 0; mode < totalModes; mode++) {
+        const LedMode& entry = led_mode(mode);
+        volatile uint32_t sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_FRAMES; i++) {
+            sink += led_mode_render(mode, frame, HW::NUM_LEDS, i * FRAME_MS, entry.max_value / 2);
+            sink += frame[i % HW::NUM_LEDS].r;
+        }
+        double mean_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCH_FRAMES;
+
+        char message[96];
+        snprintf(message, sizeof(message), "%-10s %d LEDs: %.0f ns per frame (budget %u us)",
+                 entry.name, HW::NUM_LEDS, mean_ns, (unsigned)HW::LED_EFFECT_BUDGET_US);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_LESS_THAN(HW::LED_EFFECT_BUDGET_US * 1000.0, mean_ns);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_names_follow_the_registry);
+    RUN_TEST(test_out_of_range_mode_clears_the_ring);
+    RUN_TEST(test_position_lights_one_led);
+    RUN_TEST(test_beat_flashes_and_decays);
+    RUN_TEST(test_comet_head_moves);
+    RUN_TEST(test_benchmark_every_mode_within_budget);
+    return UNITY_END();
+}
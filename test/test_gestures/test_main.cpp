@@ -0,0 +1,210 @@
+// test/test_gestures/test_main.cpp
+
+#include <unity.h>
+#include <vector>
+#include "gestures.h"
+
+constexpr uint32_t SAMPLE_US = 10000; // FT6336 report rate in active mode
+
+static GestureRecognizer recognizer;
+static std::vector<GestureResult> results; // Everything but Gesture::None
+static uint32_t now_us = 1000000;
+
+void setUp(void) {
+    recognizer = GestureRecognizer();
+    results.clear();
+}
+
+void tearDown(void) {}
+
+// =========================================================================
+// TRACE HELPERS
+// Recorded traces are a controller report every SAMPLE_US; these build them
+// from straight strokes.
+// =========================================================================
+
+static void feed(uint8_t count, int16_t x0, int16_t y0, int16_t x1 = 0, int16_t y1 = 0) {
+    TouchSample sample = {now_us, count, {x0, x1}, {y0, y1}};
+    GestureResult result = recognizer.feed(sample);
+    if (result.gesture != Gesture::None) results.push_back(result);
+    now_us += SAMPLE_US;
+}
+
+/**
+ * @brief One finger from (x0, y0) to (x1, y1) over duration_us, then lifted.
+ */
+static void stroke(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint32_t duration_us) {
+    uint32_t samples = duration_us / SAMPLE_US;
+    for (uint32_t i = 0; i <= samples; i++) {
+        feed(1, x0 + (x1 - x0) * (int32_t)i / (int32_t)samples, y0 + (y1 - y0) * (int32_t)i / (int32_t)samples);
+    }
+    feed(0, 0, 0);
+}
+
+/**
+ * @brief Two fingers 60 px apart moving together vertically by dy, then lifted.
+ */
+static void two_finger_drag(int16_t x, int16_t y, int16_t dy, uint32_t duration_us) {
+    uint32_t samples = duration_us / SAMPLE_US;
+    for (uint32_t i = 0; i <= samples; i++) {
+        int16_t offset = dy * (int32_t)i / (int32_t)samples;
+        feed(2, x - 30, y + offset, x + 30, y + offset);
+    }
+    feed(0, 0, 0);
+}
+
+static int volume_total() {
+    int total = 0;
+    for (const GestureResult& r : results) {
+        if (r.gesture == Gesture::VolumeDrag) total += r.value;
+    }
+    return total;
+}
+
+// =========================================================================
+// SWIPES
+// =========================================================================
+
+void test_quick_stroke_left_is_a_swipe() {
+    stroke(300, 240, 100, 250, 200000);
+    TEST_ASSERT_EQUAL(1, results.size());
+    TEST_ASSERT_EQUAL((int)Gesture::SwipeLeft, (int)results[0].gesture);
+}
+
+void test_quick_stroke_right_is_a_swipe() {
+    stroke(100, 240, 300, 230, 200000);
+    TEST_ASSERT_EQUAL(1, results.size());
+    TEST_ASSERT_EQUAL((int)Gesture::SwipeRight, (int)results[0].gesture);
+}
+
+void test_swipe_reports_where_it_started() {
+    stroke(300, 240, 100, 250, 200000);
+    TEST_ASSERT_EQUAL(300, results[0].start_x);
+    TEST_ASSERT_EQUAL(240, results[0].start_y);
+}
+
+void test_slow_drag_is_not_a_swipe() {
+    stroke(300, 240, 100, 240, 800000);
+    TEST_ASSERT_EQUAL(0, results.size());
+}
+
+void test_short_or_diagonal_stroke_is_not_a_swipe() {
+    stroke(200, 240, 140, 240, 100000); // 60 px
+    stroke(100, 100, 200, 250, 200000); // More vertical than horizontal
+    TEST_ASSERT_EQUAL(0, results.size());
+}
+
+// =========================================================================
+// LONG PRESS
+// =========================================================================
+
+void test_held_finger_is_a_long_press_once() {
+    stroke(160, 120, 160, 120, 1500000);
+    TEST_ASSERT_EQUAL(1, results.size());
+    TEST_ASSERT_EQUAL((int)Gesture::LongPress, (int)results[0].gesture);
+    TEST_ASSERT_EQUAL(160, results[0].start_x);
+}
+
+void test_long_press_fires_on_time() {
+    GestureConfig config;
+    uint32_t start = now_us;
+    for (int i = 0; i < 100 && results.empty(); i++) feed(1, 160, 120);
+    TEST_ASSERT_EQUAL(1, results.size());
+    uint32_t fired = now_us - SAMPLE_US - start;
+    TEST_ASSERT_GREATER_OR_EQUAL(config.long_press_us, fired);
+    TEST_ASSERT_LESS_THAN(config.long_press_us + SAMPLE_US, fired);
+    feed(0, 0, 0);
+}
+
+void test_jitter_inside_the_slop_is_still_a_press() {
+    for (int i = 0; i < 80; i++) feed(1, 160 + (i % 3) * 5 - 5, 120 + (i % 2) * 8 - 4);
+    feed(0, 0, 0);
+    TEST_ASSERT_EQUAL(1, results.size());
+    TEST_ASSERT_EQUAL((int)Gesture::LongPress, (int)results[0].gesture);
+}
+
+void test_moving_away_cancels_the_long_press() {
+    // Out of the slop radius and back: a drag, even if it ends where it began
+    for (int i = 0; i < 10; i++) feed(1, 160 + i * 4, 120);
+    for (int i = 10; i >= 0; i--) feed(1, 160 + i * 4, 120);
+    for (int i = 0; i < 80; i++) feed(1, 160, 120);
+    feed(0, 0, 0);
+    TEST_ASSERT_EQUAL(0, results.size());
+}
+
+// =========================================================================
+// TWO-FINGER VOLUME
+// =========================================================================
+
+void test_dragging_up_raises_the_volume() {
+    GestureConfig config;
+    two_finger_drag(160, 300, -80, 400000);
+    TEST_ASSERT_EQUAL(80 / config.volume_px_per_step, volume_total());
+}
+
+void test_dragging_down_lowers_the_volume() {
+    GestureConfig config;
+    two_finger_drag(160, 100, 80, 400000);
+    TEST_ASSERT_EQUAL(-80 / config.volume_px_per_step, volume_total());
+}
+
+void test_slow_drag_loses_no_steps() {
+    // 1 px per sample: every step comes from travel below the step size
+    GestureConfig config;
+    two_finger_drag(160, 300, -100, 1000000);
+    TEST_ASSERT_EQUAL(100 / config.volume_px_per_step, volume_total());
+}
+
+void test_second_finger_turns_a_stroke_into_a_drag() {
+    // Starts like a swipe, then a second finger lands: no swipe on release
+    for (int i = 0; i < 5; i++) feed(1, 300 - i * 30, 240);
+    for (int i = 0; i < 10; i++) feed(2, 150, 240 - i * 8, 210, 240 - i * 8);
+    feed(1, 150, 168); // Second finger lifts first
+    feed(0, 0, 0);
+    for (const GestureResult& r : results) {
+        TEST_ASSERT_EQUAL((int)Gesture::VolumeDrag, (int)r.gesture);
+        TEST_ASSERT_EQUAL(300, r.start_x);
+    }
+    TEST_ASSERT_EQUAL(9, volume_total());
+}
+
+// =========================================================================
+// DETERMINISM
+// =========================================================================
+
+void test_same_trace_gives_same_gestures() {
+    auto run = [] {
+        stroke(300, 240, 100, 250, 200000);
+        stroke(160, 120, 160, 120, 900000);
+        two_finger_drag(160, 300, -64, 300000);
+    };
+    run();
+    std::vector<GestureResult> first = results;
+    results.clear();
+    recognizer = GestureRecognizer();
+    run();
+    TEST_ASSERT_EQUAL(first.size(), results.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        TEST_ASSERT_EQUAL((int)first[i].gesture, (int)results[i].gesture);
+        TEST_ASSERT_EQUAL(first[i].value, results[i].value);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_quick_stroke_left_is_a_swipe);
+    RUN_TEST(test_quick_stroke_right_is_a_swipe);
+    RUN_TEST(test_swipe_reports_where_it_started);
+    RUN_TEST(test_slow_drag_is_not_a_swipe);
+    RUN_TEST(test_short_or_diagonal_stroke_is_not_a_swipe);
+    RUN_TEST(test_held_finger_is_a_long_press_once);
+    RUN_TEST(test_long_press_fires_on_time);
+    RUN_TEST(test_jitter_inside_the_slop_is_still_a_press);
+    RUN_TEST(test_moving_away_cancels_the_long_press);
+    RUN_TEST(test_dragging_up_raises_the_volume);
+    RUN_TEST(test_dragging_down_lowers_the_volume);
+    RUN_TEST(test_slow_drag_loses_no_steps);
+    RUN_TEST(test_second_finger_turns_a_stroke_into_a_drag);
+    RUN_TEST(test_same_trace_gives_same_gestures);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+// test/test_input_events/test_main.cpp
+
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include "input_events.h"
+#include "buttons.h"
+
+static std::vector<ButtonEvent> button_log;
+
+static void log_button_event(const ButtonEvent& event, void* ctx) {
+    button_log.push_back(event);
+}
+
+static InputEvent make_event(uint32_t time_us, InputEventType type, uint8_t id = 0, int16_t delta = 0) {
+    return InputEvent{time_us, type, id, delta, delta, 0, 0};
+}
+
+void setUp(void) {
+    button_log.clear();
+}
+
+void tearDown(void) {}
+
+// =========================================================================
+// RING
+// =========================================================================
+
+void test_pops_in_push_order() {
+    InputEventRing<8> ring;
+    TEST_ASSERT_TRUE(ring.empty());
+    for (uint32_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(ring.push(make_event(i * 100, InputEventType::EncoderStep, 0, i)));
+    }
+    InputEvent event;
+    for (uint32_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(ring.pop(event));
+        TEST_ASSERT_EQUAL_UINT32(i * 100, event.time_us);
+        TEST_ASSERT_EQUAL_INT(i, event.delta);
+    }
+    TEST_ASSERT_FALSE(ring.pop(event));
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_full_ring_drops_new_events() {
+    InputEventRing<4> ring;
+    for (uint32_t i = 0; i < 6; i++) {
+        ring.push(make_event(i, InputEventType::ButtonDown));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, ring.dropped());
+
+    // The oldest four survive; nothing the consumer hasn't seen is overwritten
+    InputEvent event;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.pop(event));
+        TEST_ASSERT_EQUAL_UINT32(i, event.time_us);
+    }
+    TEST_ASSERT_TRUE(ring.push(make_event(99, InputEventType::ButtonUp)));
+    TEST_ASSERT_TRUE(ring.pop(event));
+    TEST_ASSERT_EQUAL_UINT32(99, event.time_us);
+}
+
+void test_wraps_many_times() {
+    InputEventRing<4> ring;
+    InputEvent event;
+    for (uint32_t i = 0; i < 10000; i++) {
+        TEST_ASSERT_TRUE(ring.push(make_event(i, InputEventType::TouchMove)));
+        if (i % 3 == 2) {
+            // Drain in bursts so head and tail sit at every offset
+            while (ring.pop(event)) {}
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ring.dropped());
+}
+
+void test_two_threads_lose_and_reorder_nothing() {
+    static InputEventRing<32> ring;
+    constexpr uint32_t EVENTS = 200000;
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < EVENTS; i++) {
+            while (!ring.push(make_event(i, InputEventType::EncoderStep))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool in_order = true;
+    InputEvent event;
+    while (expected < EVENTS) {
+        if (ring.pop(event)) {
+            in_order &= (event.time_us == expected);
+            expected++;
+        }
+    }
+    producer.join();
+    TEST_ASSERT_TRUE(in_order);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// =========================================================================
+// RECORD AND REPLAY
+// =========================================================================
+
+// A recorded trace: a bouncy click on BACK, then a double click and a hold on MODE
+static const InputEvent TRACE[] = {
+    {1000000, InputEventType::ButtonDown, BUTTON_BACK},
+    {1000400, InputEventType::ButtonUp,   BUTTON_BACK},  // Bounce
+    {1000900, InputEventType::ButtonDown, BUTTON_BACK},  // Bounce
+    {1080000, InputEventType::ButtonUp,   BUTTON_BACK},
+    {1500000, InputEventType::ButtonDown, BUTTON_MODE},
+    {1560000, InputEventType::ButtonUp,   BUTTON_MODE},
+    {1650000, InputEventType::ButtonDown, BUTTON_MODE},
+    {1700000, InputEventType::ButtonUp,   BUTTON_MODE},
+    {2500000, InputEventType::ButtonDown, BUTTON_MODE},
+    {4000000, InputEventType::ButtonUp,   BUTTON_MODE},
+};
+constexpr size_t TRACE_LENGTH = sizeof(TRACE) / sizeof(TRACE[0]);
+constexpr uint32_t TICK_US = 1000; // loop() pass
+
+/**
+ * @brief Feeds a trace through a ring into the button engine, ticking like
+ *        loop() does, with all times shifted by offset_us.
+ */
+static void replay(uint32_t offset_us) {
+    InputEventRing<16> ring;
+    size_t next = 0;
+    InputEvent event;
+    uint32_t end_us = TRACE[TRACE_LENGTH - 1].time_us + 1000000;
+    for (uint32_t now = TRACE[0].time_us; now <= end_us; now += TICK_US) {
+        while (next < TRACE_LENGTH && TRACE[next].time_us <= now) {
+            event = TRACE[next++];
+            event.time_us += offset_us;
+            ring.push(event);
+        }
+        while (ring.pop(event)) buttons_feed(event);
+        buttons_tick(now + offset_us);
+    }
+}
+
+void test_replay_is_deterministic() {
+    replay(0);
+    std::vector<ButtonEvent> first = button_log;
+    button_log.clear();
+    replay(10000000); // Same trace later on: every button is idle again by now
+    std::vector<ButtonEvent> second = button_log;
+
+    TEST_ASSERT_GREATER_THAN(0, first.size());
+    TEST_ASSERT_EQUAL(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(first[i].time_us + 10000000, second[i].time_us);
+        TEST_ASSERT_EQUAL(first[i].button, second[i].button);
+        TEST_ASSERT_EQUAL((int)first[i].action, (int)second[i].action);
+        TEST_ASSERT_EQUAL(first[i].repeat, second[i].repeat);
+    }
+}
+
+void test_replay_decodes_the_trace() {
+    replay(20000000);
+    int back_clicks = 0, mode_double = 0, mode_repeats = 0;
+    for (const ButtonEvent& e : button_log) {
+        if (e.button == BUTTON_BACK && e.action == ButtonAction::Click) back_clicks++;
+        if (e.button == BUTTON_MODE && e.action == ButtonAction::DoubleClick) mode_double++;
+        if (e.button == BUTTON_MODE && e.action == ButtonAction::Repeat) mode_repeats++;
+    }
+    TEST_ASSERT_EQUAL(1, back_clicks);  // The bounces don't make a second click
+    TEST_ASSERT_EQUAL(1, mode_double);
+    TEST_ASSERT_GREATER_THAN(0, mode_repeats);
+}
+
+int main(int argc, char** argv) {
+    // The timing hardware_init() uses
+    buttons_configure(BUTTON_BACK, BUTTON_CONFIG_DEFAULT);
+    buttons_configure(BUTTON_MODE, {5000, 0, 300000, 600000, 400000});
+    buttons_subscribe(log_button_event, nullptr);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_pops_in_push_order);
+    RUN_TEST(test_full_ring_drops_new_events);
+    RUN_TEST(test_wraps_many_times);
+    RUN_TEST(test_two_threads_lose_and_reorder_nothing);
+    RUN_TEST(test_replay_is_deterministic);
+    RUN_TEST(test_replay_decodes_the_trace);
+    return UNITY_END();
+}
@@ -0,0 +1,188 @@
+// test/test_json_arena/test_main.cpp
+
+#include <unity.h>
+#include <chrono>
+#include <stdlib.h>
+#include "json_arena.h"
+
+// The native env sets ARDUINOJSON_POOL_CAPACITY=64 so a pool takes 1024 bytes,
+// as on the ESP32 (128 slots of 8 bytes). The slot count still differs: a host
+// pool fills after 64 values where the device's fills after 128, and strings
+// and pointers are wider here. High water and timings are host figures; only
+// the heap call counts carry over to the device.
+
+// A typical image metadata message: the handler keeps url, track and artist
+static const char IMAGE_MESSAGE[] =
+    "{\"url\":\"http://192.168.1.10:8123/api/media_player_proxy/media_player.spotify?token=abc123\","
+    "\"track\":\"Windowlicker\",\"artist\":\"Aphex Twin\",\"album\":\"Windowlicker EP\","
+    "\"duration\":367,\"position\":12,\"source\":\"Spotify\",\"shuffle\":false,\"repeat\":\"off\"}";
+
+/**
+ * @brief ArduinoJson's default behaviour (malloc/realloc/free), with counters.
+ */
+class CountingAllocator : public ArduinoJson::Allocator {
+public:
+    void* allocate(size_t size) override {
+        allocations++;
+        return malloc(size);
+    }
+    void deallocate(void* ptr) override {
+        free(ptr);
+    }
+    void* reallocate(void* ptr, size_t new_size) override {
+        reallocations++;
+        return realloc(ptr, new_size);
+    }
+
+    uint32_t allocations = 0;
+    uint32_t reallocations = 0;
+};
+
+static JsonDocument image_filter;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =========================================================================
+// ALLOCATOR
+// =========================================================================
+
+void test_allocations_are_aligned_and_counted() {
+    static JsonArena<256> arena;
+    arena.reset();
+    void* a = arena.allocate(3);
+    void* b = arena.allocate(10);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)a % 8);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)b % 8);
+    TEST_ASSERT_EQUAL(16 + 24, arena.high_water()); // Header + payload, each rounded to 8
+}
+
+void test_last_block_is_freed_and_grown_in_place() {
+    static JsonArena<256> arena;
+    arena.reset();
+    arena.allocate(16);
+    void* last = arena.allocate(16);
+    arena.deallocate(last);
+    void* again = arena.allocate(16);
+    TEST_ASSERT_TRUE(again == last);
+
+    void* grown = arena.reallocate(again, 100);
+    TEST_ASSERT_TRUE(grown == again);
+    memset(grown, 0xAB, 100);
+    TEST_ASSERT_EQUAL(0, arena.failures());
+}
+
+void test_older_block_moves_when_grown() {
+    static JsonArena<256> arena;
+    arena.reset();
+    char* first = (char*)arena.allocate(8);
+    memcpy(first, "arena!!", 8);
+    arena.allocate(8);
+    char* moved = (char*)arena.reallocate(first, 32);
+    TEST_ASSERT_NOT_NULL(moved);
+    TEST_ASSERT_TRUE(moved != first);
+    TEST_ASSERT_EQUAL_STRING("arena!!", moved);
+}
+
+void test_exhaustion_fails_without_touching_the_heap() {
+    static JsonArena<64> arena;
+    arena.reset();
+    TEST_ASSERT_NOT_NULL(arena.allocate(40));
+    TEST_ASSERT_NULL(arena.allocate(40));
+    TEST_ASSERT_EQUAL(1, arena.failures());
+
+    arena.reset();
+    TEST_ASSERT_NOT_NULL(arena.allocate(40)); // reset() gives everything back
+}
+
+// =========================================================================
+// PARSING
+// =========================================================================
+
+void test_filtered_parse_fits_the_arena() {
+    static JsonArena<2048> arena;
+    arena.reset();
+    JsonDocument doc(&arena);
+    DeserializationError error = deserializeJson(doc, IMAGE_MESSAGE, strlen(IMAGE_MESSAGE),
+                                                 DeserializationOption::Filter(image_filter));
+    TEST_ASSERT_FALSE(error);
+    TEST_ASSERT_EQUAL_STRING("Windowlicker", doc["track"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("Aphex Twin", doc["artist"].as<const char*>());
+    TEST_ASSERT_TRUE(doc["album"].isNull()); // Filtered out
+    TEST_ASSERT_EQUAL(0, arena.failures());
+    TEST_ASSERT_LESS_OR_EQUAL(arena.capacity(), arena.high_water());
+}
+
+void test_too_small_arena_reports_no_memory() {
+    static JsonArena<64> arena;
+    arena.reset();
+    JsonDocument doc(&arena);
+    DeserializationError error = deserializeJson(doc, IMAGE_MESSAGE, strlen(IMAGE_MESSAGE),
+                                                 DeserializationOption::Filter(image_filter));
+    TEST_ASSERT_TRUE(error == DeserializationError::NoMemory);
+    TEST_ASSERT_GREATER_THAN(0, arena.failures());
+}
+
+// =========================================================================
+// BENCHMARK
+// =========================================================================
+
+constexpr int BENCH_ITERATIONS = 20000;
+
+/**
+ * @brief Parses the same message with the arena and with heap allocation and
+ *        prints both. Timings are informational; the heap counts are exact.
+ */
+void test_benchmark_arena_against_default_allocator() {
+    using Clock = std::chrono::steady_clock;
+    static JsonArena<2048> arena;
+    CountingAllocator heap;
+    size_t checksum = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        arena.reset();
+        JsonDocument doc(&arena);
+        deserializeJson(doc, IMAGE_MESSAGE, strlen(IMAGE_MESSAGE), DeserializationOption::Filter(image_filter));
+        checksum += strlen(doc["track"].as<const char*>());
+    }
+    double arena_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BENCH_ITERATIONS;
+
+    start = Clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        JsonDocument doc(&heap);
+        deserializeJson(doc, IMAGE_MESSAGE, strlen(IMAGE_MESSAGE), DeserializationOption::Filter(image_filter));
+        checksum += strlen(doc["track"].as<const char*>());
+    }
+    double heap_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BENCH_ITERATIONS;
+
+    char report[160];
+    snprintf(report, sizeof(report),
+             "arena: %.0f ns/parse, 0 heap calls, %u B high water | heap: %.0f ns/parse, %.1f allocs + %.1f reallocs/parse",
+             arena_ns, (unsigned)arena.high_water(), heap_ns,
+             (double)heap.allocations / BENCH_ITERATIONS, (double)heap.reallocations / BENCH_ITERATIONS);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_EQUAL(2 * BENCH_ITERATIONS * strlen("Windowlicker"), checksum);
+    TEST_ASSERT_EQUAL(0, arena.failures());
+    TEST_ASSERT_GREATER_THAN(0, heap.allocations); // What the arena saves on every message
+}
+
+int main(int argc, char** argv) {
+    image_filter["url"] = true;
+    image_filter["track"] = true;
+    image_filter["artist"] = true;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_allocations_are_aligned_and_counted);
+    RUN_TEST(test_last_block_is_freed_and_grown_in_place);
+    RUN_TEST(test_older_block_moves_when_grown);
+    RUN_TEST(test_exhaustion_fails_without_touching_the_heap);
+    RUN_TEST(test_filtered_parse_fits_the_arena);
+    RUN_TEST(test_too_small_arena_reports_no_memory);
+    RUN_TEST(test_benchmark_arena_against_default_allocator);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+// test/test_latency_histogram/test_main.cpp
+
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+#include "latency_histogram.h"
+
+static LatencyHistogram histogram;
+
+void setUp(void) {
+    histogram.reset();
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief The value at the percentile by nearest rank, what percentile() approximates.
+ */
+static uint32_t exact_percentile(std::vector<uint32_t> values, uint8_t pct) {
+    std::sort(values.begin(), values.end());
+    size_t rank = (values.size() * pct + 99) / 100;
+    if (rank == 0) rank = 1;
+    return values[rank - 1];
+}
+
+// =========================================================================
+// TESTS
+// =========================================================================
+
+void test_empty_reports_zero() {
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.max());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.percentile(99));
+}
+
+void test_small_values_are_exact() {
+    for (uint32_t v = 0; v < 8; v++) {
+        histogram.reset();
+        histogram.record(v);
+        TEST_ASSERT_EQUAL_UINT32(v, histogram.percentile(50));
+    }
+}
+
+void test_single_value_reports_itself() {
+    // The bucket's upper bound is capped at the largest value seen
+    histogram.record(1000);
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.percentile(100));
+}
+
+void test_percentile_is_at_most_25_percent_high() {
+    std::vector<uint32_t> values;
+    uint32_t rng = 1;
+    for (int i = 0; i < 10000; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        uint32_t v = 8 + (rng >> 8) % 100000;
+        values.push_back(v);
+        histogram.record(v);
+    }
+    const uint8_t pcts[] = {1, 10, 50, 90, 95, 99, 100};
+    for (uint8_t pct : pcts) {
+        uint32_t exact = exact_percentile(values, pct);
+        uint32_t reported = histogram.percentile(pct);
+        TEST_ASSERT_GREATER_OR_EQUAL(exact, reported);
+        TEST_ASSERT_LESS_OR_EQUAL(exact + exact / 4, reported);
+    }
+}
+
+void test_every_bucket_boundary() {
+    // Each value lands in a bucket whose upper bound is no lower and within 25%.
+    // The last bucket also holds the overflow and reports max() instead.
+    for (uint32_t v = 8; v < (7u << 14); v++) {
+        histogram.reset();
+        histogram.record(v);
+        histogram.record(1u << 20); // Keeps the max from capping the bound
+        uint32_t reported = histogram.percentile(50);
+        TEST_ASSERT_GREATER_OR_EQUAL(v, reported);
+        TEST_ASSERT_LESS_OR_EQUAL(v + v / 4, reported);
+    }
+}
+
+void test_overflow_bucket_reports_max() {
+    histogram.record(10);
+    histogram.record(500000);
+    histogram.record(3000000);
+    TEST_ASSERT_EQUAL_UINT32(3000000, histogram.max());
+    TEST_ASSERT_EQUAL_UINT32(3000000, histogram.percentile(99));
+    TEST_ASSERT_UINT32_WITHIN(2, 10, histogram.percentile(1));
+}
+
+void test_tail_is_not_hidden_by_the_median() {
+    for (int i = 0; i < 990; i++) histogram.record(100);
+    for (int i = 0; i < 10; i++) histogram.record(20000);
+    TEST_ASSERT_UINT32_WITHIN(25, 100, histogram.percentile(50));
+    TEST_ASSERT_UINT32_WITHIN(25, 100, histogram.percentile(99));
+    TEST_ASSERT_GREATER_OR_EQUAL(20000, histogram.percentile(100));
+    histogram.record(20000);
+    TEST_ASSERT_GREATER_OR_EQUAL(20000, histogram.percentile(99));
+}
+
+void test_reset_clears_everything() {
+    histogram.record(5);
+    histogram.record(70000);
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.max());
+    histogram.record(3);
+    TEST_ASSERT_EQUAL_UINT32(3, histogram.percentile(100));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_reports_zero);
+    RUN_TEST(test_small_values_are_exact);
+    RUN_TEST(test_single_value_reports_itself);
+    RUN_TEST(test_percentile_is_at_most_25_percent_high);
+    RUN_TEST(test_every_bucket_boundary);
+    RUN_TEST(test_overflow_bucket_reports_max);
+    RUN_TEST(test_tail_is_not_hidden_by_the_median);
+    RUN_TEST(test_reset_clears_everything);
+    return UNITY_END();
+}
@@ -0,0 +1,95 @@
+// test/test_led_math/test_main.cpp
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+
+// What a translation unit sees when FastLED.h comes first: sin8 is a macro
+// and scale8 a global function. led_math.h must compile and work next to them.
+#define sin8 sin8_C
+static uint8_t scale8(uint8_t i, uint8_t scale) { return ((uint16_t)i * (1 + scale)) >> 8; }
+
+#include "led_math.h"
+
+constexpr int BENCH_ROUNDS = 20000; // x 256 values
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static double ns_per_call(std::chrono::steady_clock::time_point start, int calls) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+// =========================================================================
+// ACCURACY
+// =========================================================================
+
+void test_sine_matches_libm() {
+    for (int i = 0; i < 256; i++) {
+        double exact = 128.0 + 127.5 * sin(2 * M_PI * i / 256);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, (float)exact, led_math::sine_u8(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(255, led_math::sine_u8(64));
+    TEST_ASSERT_EQUAL_UINT8(0, led_math::sine_u8(192));
+}
+
+void test_gamma_matches_libm_and_rises() {
+    for (int i = 0; i < 256; i++) {
+        double exact = 255.0 * pow(i / 255.0, 2.5);
+        TEST_ASSERT_FLOAT_WITHIN(0.51f, (float)exact, led_math::gamma_u8(i));
+        if (i > 0) TEST_ASSERT_GREATER_OR_EQUAL(led_math::gamma_u8(i - 1), led_math::gamma_u8(i));
+    }
+}
+
+void test_fastled_names_are_left_alone() {
+    // The global scale8 above is still the one an unqualified call finds
+    TEST_ASSERT_EQUAL_UINT8(78, scale8(200, 100));
+    TEST_ASSERT_EQUAL_UINT8(255, led_math::sine_u8(64));
+}
+
+// =========================================================================
+// BENCHMARK
+// On the host this shows the relative cost only; the ESP32-S3 has a single-
+// precision FPU, so libm sin/pow are far slower there than a table lookup.
+// =========================================================================
+
+void test_benchmark_tables_against_libm() {
+    volatile uint32_t sink = 0;
+    const int calls = BENCH_ROUNDS * 256;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++) sum += led_math::gamma_u8(led_math::sine_u8(i + r));
+        sink += sum;
+    }
+    double table_ns = ns_per_call(start, calls);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++) {
+            float s = 128.0f + 127.5f * sinf(2 * (float)M_PI * (uint8_t)(i + r) / 256);
+            sum += (uint8_t)(255.0f * powf((uint8_t)s / 255.0f, 2.5f) + 0.5f);
+        }
+        sink += sum;
+    }
+    double libm_ns = ns_per_call(start, calls);
+
+    char message[96];
+    snprintf(message, sizeof(message), "gamma(sine(x)): %.2f ns tables, %.2f ns sinf+powf", table_ns, libm_ns);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(libm_ns, table_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sine_matches_libm);
+    RUN_TEST(test_gamma_matches_libm_and_rises);
+    RUN_TEST(test_fastled_names_are_left_alone);
+    RUN_TEST(test_benchmark_tables_against_libm);
+    return UNITY_END();
+}
@@ -0,0 +1,305 @@
+// test/test_mqtt_replay/test_main.cpp
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <PubSubClient.h>
+#include "config.h"
+#include "mqtt_dispatch.h"
+#include "mqtt_handlers.h"
+#include "music_image.h"
+
+// Replay pacing; override with -D in build_flags to try other loads
+#ifndef REPLAY_RATE_HZ
+#define REPLAY_RATE_HZ 2000 // Messages per second, all traces interleaved
+#endif
+#ifndef REPLAY_MESSAGES
+#define REPLAY_MESSAGES 500 // Per trace
+#endif
+
+constexpr size_t SINK_CAPACITY = 4096;
+
+// =========================================================================
+// ALLOCATION COUNTER
+// Counts heap calls while `counting` is set. On glibc malloc itself is
+// replaced, which also sees operator new and C allocations inside libraries;
+// elsewhere only operator new is counted.
+// =========================================================================
+
+static bool counting = false;
+static uint32_t allocations = 0;
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+extern "C" void* malloc(size_t size) {
+    if (counting) allocations++;
+    return __libc_malloc(size);
+}
+extern "C" void* calloc(size_t count, size_t size) {
+    if (counting) allocations++;
+    return __libc_calloc(count, size);
+}
+extern "C" void* realloc(void* ptr, size_t size) {
+    if (counting) allocations++;
+    return __libc_realloc(ptr, size);
+}
+#else
+void* operator new(size_t size) {
+    if (counting) allocations++;
+    void* ptr = malloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+#endif
+
+// =========================================================================
+// TRACES
+// Payloads as the bridge and Home Assistant send them.
+// =========================================================================
+
+struct TraceMessage {
+    const uint8_t* payload;
+    unsigned int   length;
+};
+
+#define TEXT(s) TraceMessage{(const uint8_t*)(s), sizeof(s) - 1}
+
+static const char IMAGE_JSON[] =
+    "{\"url\":\"http://192.168.1.10:8123/api/media_player_proxy/media_player.spotify?token=abc123\","
+    "\"track\":\"Windowlicker\",\"artist\":\"Aphex Twin\",\"album\":\"Windowlicker EP\","
+    "\"duration\":367,\"position\":12,\"source\":\"Spotify\",\"shuffle\":false,\"repeat\":\"off\"}";
+static const char IMAGE_JSON_SHORT[] =
+    "{\"url\":\"http://192.168.1.10/cover.png\",\"track\":\"Xtal\",\"artist\":\"Aphex Twin\"}";
+
+// {0: 204, 1: 107, 2: true, 3: false, 4: 65, 5: 1760000000123}
+static const uint8_t MUSIC_MSGPACK[] = {
+    0x86, 0x00, 0xCC, 0xCC, 0x01, 0x6B, 0x02, 0xC3, 0x03, 0xC2, 0x04, 0x41,
+    0x05, 0xCF, 0x00, 0x00, 0x01, 0x99, 0xC8, 0x2C, 0xC0, 0x7B,
+};
+static const uint8_t MUSIC_MSGPACK_MINIMAL[] = {0x82, 0x00, 0xCC, 0xCC, 0x01, 0x6C};
+static const char MUSIC_JSON[] =
+    "{\"length\":204,\"elapsed\":109,\"playing\":true,\"shuffle\":false,\"volume\":65,\"ts\":1760000002123}";
+
+static const TraceMessage IMAGE_TRACE[] = {TEXT(IMAGE_JSON), TEXT(IMAGE_JSON_SHORT)};
+static const TraceMessage MUSIC_TRACE[] = {
+    {MUSIC_MSGPACK, sizeof(MUSIC_MSGPACK)}, {MUSIC_MSGPACK_MINIMAL, sizeof(MUSIC_MSGPACK_MINIMAL)}, TEXT(MUSIC_JSON),
+};
+static const TraceMessage BRIGHTNESS_TRACE[] = {TEXT("0"), TEXT("128"), TEXT("255"), TEXT("300")};
+static const TraceMessage COMMAND_TRACE[] = {TEXT("led_on"), TEXT("led_off"), TEXT("LED_ON"), TEXT("beat_test 128")};
+
+struct Trace {
+    const char*         name;
+    const char*         topic;
+    const TraceMessage* messages;
+    size_t              count;
+    uint32_t            handled;     // Sink calls seen
+    uint32_t            allocations; // Heap calls during its messages
+    std::vector<double> latency_ns;  // Whole path: client, sink, dispatch, handler
+};
+
+static Trace traces[] = {
+    {"image",      Config::topic_image,      IMAGE_TRACE,      2, 0, 0, {}},
+    {"music",      Config::topic_music,      MUSIC_TRACE,      3, 0, 0, {}},
+    {"brightness", Config::topic_brightness, BRIGHTNESS_TRACE, 4, 0, 0, {}},
+    {"command",    Config::topic_command,    COMMAND_TRACE,    4, 0, 0, {}},
+};
+enum TraceIndex { IMAGE, MUSIC, BRIGHTNESS, COMMAND };
+
+// =========================================================================
+// STUBBED UI SINKS
+// =========================================================================
+
+static uint8_t last_brightness = 0;
+static bool leds_on = false;
+
+static void stub_music(const MusicStatus& status) { traces[MUSIC].handled++; }
+static void stub_brightness(uint8_t level) { last_brightness = level; traces[BRIGHTNESS].handled++; }
+static void stub_leds_on(bool on) { leds_on = on; traces[COMMAND].handled++; }
+static void stub_reboot() { TEST_FAIL_MESSAGE("reboot is not in the trace"); }
+static void stub_beat_test(uint16_t bpm) { traces[COMMAND].handled++; }
+
+static const MqttHandlerSinks STUB_SINKS = {stub_music, stub_brightness, stub_leds_on, stub_reboot, stub_beat_test};
+
+// Stands in for music_player.cpp's handler, which queues the info for the downloader
+static void handle_image_message(const char* payload, unsigned int length) {
+    MusicInfo info;
+    if (music_image_decode(payload, length, info)) traces[IMAGE].handled++;
+}
+
+// =========================================================================
+// CLIENT AND DISPATCH, wired as in mqtt.cpp
+// =========================================================================
+
+static PubSubClient client;
+static PayloadSink sink;
+static MqttDispatcher dispatcher;
+static MqttDispatchResult last_result;
+
+static void on_message(char* topic, uint8_t* payload, unsigned int length) {
+    last_result = dispatcher.dispatch(topic, payload, length, &sink);
+}
+
+static MqttDispatchResult deliver(const char* topic, const uint8_t* payload, unsigned int length) {
+    sink.reset();
+    client.deliver(topic, payload, length);
+    return last_result;
+}
+
+static MqttDispatchResult deliver(const char* topic, const char* text) {
+    return deliver(topic, (const uint8_t*)text, strlen(text));
+}
+
+static void ignore(const char* payload, unsigned int length) {}
+
+void setUp(void) {
+    dispatcher = MqttDispatcher();
+    dispatcher.add(mqtt_topic(Config::topic_image,      MqttPayload::Json,   handle_image_message));
+    dispatcher.add(mqtt_topic(Config::topic_music,      MqttPayload::Binary, handle_music_message));
+    dispatcher.add(mqtt_topic(Config::topic_brightness, MqttPayload::Text,   handle_brightness_message));
+    dispatcher.add(mqtt_topic(Config::topic_command,    MqttPayload::Text,   handle_command_message));
+    for (Trace& trace : traces) {
+        trace.handled = 0;
+        trace.allocations = 0;
+        trace.latency_ns.clear();
+    }
+}
+
+void tearDown(void) {}
+
+// =========================================================================
+// DISPATCH
+// =========================================================================
+
+void test_routes_to_the_handler() {
+    TEST_ASSERT_TRUE(deliver(Config::topic_brightness, "300") == MqttDispatchResult::Handled);
+    TEST_ASSERT_EQUAL_UINT8(255, last_brightness);
+    TEST_ASSERT_TRUE(deliver(Config::topic_command, "led_on") == MqttDispatchResult::Handled);
+    TEST_ASSERT_TRUE(leds_on);
+    TEST_ASSERT_EQUAL(2, traces[BRIGHTNESS].handled + traces[COMMAND].handled);
+}
+
+void test_unknown_topic_is_reported() {
+    TEST_ASSERT_TRUE(deliver("music/unknown", "1") == MqttDispatchResult::UnknownTopic);
+}
+
+void test_oversize_payload_is_dropped() {
+    std::vector<uint8_t> large(SINK_CAPACITY + 1, '1');
+    TEST_ASSERT_TRUE(deliver(Config::topic_brightness, large.data(), large.size()) == MqttDispatchResult::Oversize);
+    TEST_ASSERT_EQUAL(0, traces[BRIGHTNESS].handled);
+}
+
+void test_fallback_without_sink_copies_and_terminates() {
+    const uint8_t payload[] = {'1', '2', '8', 'X'};
+    TEST_ASSERT_TRUE(dispatcher.dispatch(Config::topic_brightness, payload, 3, nullptr) == MqttDispatchResult::Handled);
+    TEST_ASSERT_EQUAL_UINT8(128, last_brightness);
+
+    std::vector<uint8_t> large(MqttDispatcher::FALLBACK_PAYLOAD_SIZE + 1, '1');
+    TEST_ASSERT_TRUE(dispatcher.dispatch(Config::topic_brightness, large.data(), large.size(), nullptr) ==
+                     MqttDispatchResult::Oversize);
+}
+
+void test_table_rejects_duplicates_and_overfill() {
+    TEST_ASSERT_FALSE(dispatcher.add(mqtt_topic(Config::topic_music, MqttPayload::Binary, ignore)));
+    static char names[MqttDispatcher::SLOTS][16];
+    for (size_t i = 0; i < MqttDispatcher::SLOTS; i++) {
+        snprintf(names[i], sizeof(names[i]), "extra/%u", (unsigned)i);
+        bool added = dispatcher.add(mqtt_topic(names[i], MqttPayload::Text, ignore));
+        TEST_ASSERT_EQUAL(added, dispatcher.find(names[i]) != nullptr);
+    }
+    TEST_ASSERT_EQUAL(MqttDispatcher::SLOTS / 2, dispatcher.count()); // Kept at most half full
+    TEST_ASSERT_NOT_NULL(dispatcher.find(Config::topic_command));
+}
+
+// =========================================================================
+// REPLAY BENCHMARK
+// The four traces interleaved at REPLAY_RATE_HZ through the client shim,
+// the sink, the dispatcher and the real handlers. Reports per handler p50
+// and p99 of the whole path on the host, the dispatcher's own p99 (the
+// figure telemetry reports on the device) and heap calls per message.
+// =========================================================================
+
+static void report_topic(const char* topic, const MqttTopicStats& stats, void* context) {
+    for (Trace& trace : traces) {
+        if (strcmp(trace.topic, topic) != 0) continue;
+        std::vector<double>& samples = trace.latency_ns;
+        std::sort(samples.begin(), samples.end());
+        double p50 = samples[samples.size() / 2];
+        double p99 = samples[samples.size() * 99 / 100];
+
+        char message[160];
+        snprintf(message, sizeof(message),
+                 "%-10s %u msgs: p50 %.0f ns, p99 %.0f ns, dispatcher p99 %u us, %.2f heap calls/msg",
+                 trace.name, (unsigned)stats.messages, p50, p99, (unsigned)stats.latency_us.percentile(99),
+                 (double)trace.allocations / samples.size());
+        TEST_MESSAGE(message);
+    }
+}
+
+void test_replay_traces_at_rate() {
+    using Clock = std::chrono::steady_clock;
+    const size_t trace_count = sizeof(traces) / sizeof(traces[0]);
+    const size_t total = trace_count * REPLAY_MESSAGES;
+    const auto period = std::chrono::nanoseconds(1000000000 / REPLAY_RATE_HZ);
+
+    // One of each first: filters and stdio buffers are set up on first use
+    Serial.muted = true;
+    for (Trace& trace : traces) {
+        for (size_t i = 0; i < trace.count; i++) {
+            deliver(trace.topic, trace.messages[i].payload, trace.messages[i].length);
+        }
+        trace.handled = 0;
+        trace.latency_ns.reserve(REPLAY_MESSAGES);
+    }
+    dispatcher.reset_stats();
+
+    auto next = Clock::now();
+    for (size_t i = 0; i < total; i++) {
+        Trace& trace = traces[i % trace_count];
+        const TraceMessage& message = trace.messages[(i / trace_count) % trace.count];
+        std::this_thread::sleep_until(next);
+        next += period;
+
+        uint32_t before = allocations;
+        counting = true;
+        auto start = Clock::now();
+        deliver(trace.topic, message.payload, message.length);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        counting = false;
+        trace.allocations += allocations - before;
+        trace.latency_ns.push_back(ns);
+    }
+    Serial.muted = false;
+
+    char header[96];
+    snprintf(header, sizeof(header), "%u messages at %u/s", (unsigned)total, (unsigned)REPLAY_RATE_HZ);
+    TEST_MESSAGE(header);
+    dispatcher.visit_stats(report_topic, nullptr);
+
+    for (const Trace& trace : traces) {
+        TEST_ASSERT_EQUAL_MESSAGE(REPLAY_MESSAGES, trace.handled, trace.name);
+        TEST_ASSERT_EQUAL_MESSAGE(0, trace.allocations, trace.name); // The message path never touches the heap
+    }
+}
+
+int main(int argc, char** argv) {
+    sink.begin(SINK_CAPACITY);
+    client.setStream(sink);
+    client.setCallback(on_message);
+    mqtt_handlers_init(STUB_SINKS);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_routes_to_the_handler);
+    RUN_TEST(test_unknown_topic_is_reported);
+    RUN_TEST(test_oversize_payload_is_dropped);
+    RUN_TEST(test_fallback_without_sink_copies_and_terminates);
+    RUN_TEST(test_table_rejects_duplicates_and_overfill);
+    RUN_TEST(test_replay_traces_at_rate);
+    return UNITY_END();
+}
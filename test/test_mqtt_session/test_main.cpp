@@ -0,0 +1,246 @@
+// test/test_mqtt_session/test_main.cpp
+
+#include <unity.h>
+#include <string>
+#include <set>
+#include <vector>
+#include "mqtt_session.h"
+
+constexpr uint32_t BACKOFF_MIN_MS = 1000;
+constexpr uint32_t BACKOFF_MAX_MS = 60000;
+
+static const char* const TOPICS[] = {"music/status", "music/image", "esp-gui/command"};
+
+// =========================================================================
+// BROKER STAND-IN
+// Answers CONNECTs with real CONNACK bytes and keeps persistent sessions
+// the way a broker does: per client ID, until it restarts without storage.
+// =========================================================================
+
+class FakeBroker {
+public:
+    bool up = true;
+    bool refuse = false;          // Answer with return code 5 (not authorized)
+    bool keeps_sessions = true;   // Whether sessions survive restart()
+
+    /**
+     * @brief Bytes the client reads after connecting; empty when the broker is down.
+     */
+    std::vector<uint8_t> connect(bool clean_session) {
+        if (!up) return {};
+        if (refuse) return {0x20, 0x02, 0x00, 0x05};
+        bool present = !clean_session && session_;
+        if (clean_session || !session_) subscriptions_.clear();
+        session_ = !clean_session;
+        connected_ = true;
+        return {0x20, 0x02, (uint8_t)(present ? 0x01 : 0x00), 0x00};
+    }
+
+    void subscribe(const std::string& topic) { subscriptions_.insert(topic); }
+
+    void restart() {
+        connected_ = false;
+        if (!keeps_sessions) {
+            session_ = false;
+            subscriptions_.clear();
+        }
+    }
+
+    /**
+     * @brief Whether a publish on the topic would reach the client.
+     */
+    bool delivers(const std::string& topic) const {
+        return connected_ && subscriptions_.count(topic);
+    }
+
+    size_t subscriptions() const { return subscriptions_.size(); }
+
+private:
+    bool session_ = false;
+    bool connected_ = false;
+    std::set<std::string> subscriptions_;
+};
+
+// =========================================================================
+// CLIENT SIDE
+// The connect path of mqtt.cpp: arm the capture, read the CONNACK, decide
+// about subscriptions, back off on failure.
+// =========================================================================
+
+struct ClientModel {
+    bool persistent = true;
+    bool table_subscribed = false;
+    uint32_t subscribe_passes = 0;
+    ConnackCapture connack;
+    MqttBackoff backoff{BACKOFF_MIN_MS, BACKOFF_MAX_MS};
+
+    bool connect(FakeBroker& broker, uint32_t random = 0) {
+        connack.arm();
+        for (uint8_t byte : broker.connect(!persistent)) connack.feed(byte);
+        if (!connack.accepted()) {
+            backoff.fail(random);
+            return false;
+        }
+        backoff.reset();
+        if (mqtt_needs_subscribe(persistent, connack.session_present(), table_subscribed)) {
+            for (const char* topic : TOPICS) broker.subscribe(topic);
+            table_subscribed = true;
+            subscribe_passes++;
+        }
+        return true;
+    }
+};
+
+static bool receives_all(const FakeBroker& broker) {
+    for (const char* topic : TOPICS) {
+        if (!broker.delivers(topic)) return false;
+    }
+    return true;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =========================================================================
+// SESSIONS
+// =========================================================================
+
+void test_first_connect_subscribes() {
+    FakeBroker broker;
+    ClientModel client;
+    TEST_ASSERT_TRUE(client.connect(broker));
+    TEST_ASSERT_FALSE(client.connack.session_present());
+    TEST_ASSERT_EQUAL(1, client.subscribe_passes);
+    TEST_ASSERT_TRUE(receives_all(broker));
+}
+
+void test_resumed_session_skips_subscribing() {
+    FakeBroker broker;
+    ClientModel client;
+    client.connect(broker);
+    broker.restart(); // Connection drops, the broker keeps the session
+
+    TEST_ASSERT_TRUE(client.connect(broker));
+    TEST_ASSERT_TRUE(client.connack.session_present());
+    TEST_ASSERT_EQUAL(1, client.subscribe_passes);
+    TEST_ASSERT_TRUE(receives_all(broker));
+}
+
+void test_lost_session_resubscribes() {
+    FakeBroker broker;
+    broker.keeps_sessions = false;
+    ClientModel client;
+    client.connect(broker);
+    broker.restart();
+    TEST_ASSERT_EQUAL(0, broker.subscriptions());
+
+    TEST_ASSERT_TRUE(client.connect(broker));
+    TEST_ASSERT_FALSE(client.connack.session_present());
+    TEST_ASSERT_EQUAL(2, client.subscribe_passes);
+    TEST_ASSERT_TRUE(receives_all(broker));
+}
+
+void test_topic_registered_offline_resubscribes() {
+    FakeBroker broker;
+    ClientModel client;
+    client.connect(broker);
+    broker.restart();
+    client.table_subscribed = false; // What mqtt_register_topic() does while offline
+
+    client.connect(broker);
+    TEST_ASSERT_EQUAL(2, client.subscribe_passes);
+}
+
+void test_clean_session_subscribes_every_time() {
+    FakeBroker broker;
+    ClientModel client;
+    client.persistent = false;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(client.connect(broker));
+        broker.restart();
+    }
+    TEST_ASSERT_EQUAL(3, client.subscribe_passes);
+}
+
+void test_refused_connack_is_a_failure() {
+    FakeBroker broker;
+    broker.refuse = true;
+    ClientModel client;
+    TEST_ASSERT_FALSE(client.connect(broker));
+    TEST_ASSERT_FALSE(client.connack.session_present());
+    TEST_ASSERT_EQUAL(0, client.subscribe_passes);
+}
+
+void test_capture_ignores_traffic_after_the_connack() {
+    ConnackCapture connack;
+    connack.arm();
+    const uint8_t bytes[] = {0x20, 0x02, 0x01, 0x00, 0x30, 0x05, 0x00};
+    for (uint8_t byte : bytes) connack.feed(byte);
+    TEST_ASSERT_TRUE(connack.session_present());
+
+    ConnackCapture unarmed;
+    for (uint8_t byte : bytes) unarmed.feed(byte);
+    TEST_ASSERT_FALSE(unarmed.accepted());
+}
+
+// =========================================================================
+// BACKOFF
+// =========================================================================
+
+void test_backoff_doubles_to_the_cap_within_jitter() {
+    FakeBroker broker;
+    broker.up = false;
+    ClientModel client;
+    uint32_t base = BACKOFF_MIN_MS;
+    for (int attempt = 0; attempt < 12; attempt++) {
+        TEST_ASSERT_FALSE(client.connect(broker, 0x9E3779B9u * (attempt + 1)));
+        uint32_t delay = client.backoff.delay_ms();
+        TEST_ASSERT_GREATER_OR_EQUAL(base - base / 4, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(base + base / 4, delay);
+        base = base * 2 < BACKOFF_MAX_MS ? base * 2 : BACKOFF_MAX_MS;
+    }
+}
+
+void test_backoff_resets_after_connecting() {
+    FakeBroker broker;
+    broker.up = false;
+    ClientModel client;
+    for (int i = 0; i < 5; i++) client.connect(broker);
+    TEST_ASSERT_GREATER_THAN(BACKOFF_MIN_MS * 8, client.backoff.delay_ms());
+
+    broker.up = true;
+    TEST_ASSERT_TRUE(client.connect(broker));
+    TEST_ASSERT_EQUAL(0, client.backoff.delay_ms());
+
+    broker.up = false;
+    client.connect(broker, 0);
+    TEST_ASSERT_EQUAL(BACKOFF_MIN_MS - BACKOFF_MIN_MS / 4, client.backoff.delay_ms());
+}
+
+void test_jitter_spreads_devices_apart() {
+    // Ten devices losing the same broker at once
+    std::set<uint32_t> delays;
+    uint32_t rng = 12345;
+    for (int device = 0; device < 10; device++) {
+        MqttBackoff backoff(BACKOFF_MIN_MS, BACKOFF_MAX_MS);
+        rng = rng * 1664525u + 1013904223u;
+        delays.insert(backoff.fail(rng));
+    }
+    TEST_ASSERT_GREATER_THAN(5, delays.size());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_connect_subscribes);
+    RUN_TEST(test_resumed_session_skips_subscribing);
+    RUN_TEST(test_lost_session_resubscribes);
+    RUN_TEST(test_topic_registered_offline_resubscribes);
+    RUN_TEST(test_clean_session_subscribes_every_time);
+    RUN_TEST(test_refused_connack_is_a_failure);
+    RUN_TEST(test_capture_ignores_traffic_after_the_connack);
+    RUN_TEST(test_backoff_doubles_to_the_cap_within_jitter);
+    RUN_TEST(test_backoff_resets_after_connecting);
+    RUN_TEST(test_jitter_spreads_devices_apart);
+    return UNITY_END();
+}
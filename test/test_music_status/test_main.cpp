@@ -0,0 +1,175 @@
+// test/test_music_status/test_main.cpp
+
+#include <unity.h>
+#include <chrono>
+#include "music_status.h"
+
+// {0: 204, 1: 107}: the two required fields, 6 bytes
+static const uint8_t MSGPACK_MINIMAL[] = {0x82, 0x00, 0xCC, 0xCC, 0x01, 0x6B};
+
+// {0: 204, 1: 107, 2: true, 3: false, 4: 65, 5: 1760000000123}
+static const uint8_t MSGPACK_FULL[] = {
+    0x86,
+    0x00, 0xCC, 0xCC,
+    0x01, 0x6B,
+    0x02, 0xC3,
+    0x03, 0xC2,
+    0x04, 0x41,
+    0x05, 0xCF, 0x00, 0x00, 0x01, 0x99, 0xC8, 0x2C, 0xC0, 0x7B,
+};
+
+static const char JSON_MINIMAL[] = "{\"length\":204,\"elapsed\":107}";
+static const char JSON_FULL[] =
+    "{\"length\":204,\"elapsed\":107,\"playing\":true,\"shuffle\":false,\"volume\":65,"
+    "\"ts\":1760000000123,\"title\":\"ignored\"}";
+
+static bool decode(const uint8_t* payload, size_t length, MusicStatus& out) {
+    return music_status_decode(payload, length, out);
+}
+
+static bool decode(const char* payload, MusicStatus& out) {
+    return music_status_decode((const uint8_t*)payload, strlen(payload), out);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =========================================================================
+// MESSAGEPACK
+// =========================================================================
+
+void test_msgpack_required_fields() {
+    MusicStatus status;
+    TEST_ASSERT_TRUE(decode(MSGPACK_MINIMAL, sizeof(MSGPACK_MINIMAL), status));
+    TEST_ASSERT_EQUAL_UINT32(204, status.length);
+    TEST_ASSERT_EQUAL_UINT32(107, status.elapsed);
+    TEST_ASSERT_EQUAL_UINT8(0, status.fields);
+}
+
+void test_msgpack_optional_fields() {
+    MusicStatus status;
+    TEST_ASSERT_TRUE(decode(MSGPACK_FULL, sizeof(MSGPACK_FULL), status));
+    TEST_ASSERT_TRUE(status.playing);
+    TEST_ASSERT_FALSE(status.shuffle);
+    TEST_ASSERT_EQUAL_UINT8(65, status.volume);
+    TEST_ASSERT_TRUE(status.timestamp == 1760000000123ULL);
+    TEST_ASSERT_EQUAL_UINT8(MUSIC_FIELD_PLAYING | MUSIC_FIELD_SHUFFLE | MUSIC_FIELD_VOLUME | MUSIC_FIELD_TIMESTAMP,
+                            status.fields);
+}
+
+void test_msgpack_skips_unknown_keys() {
+    // {9: "hi", 0: 3, 7: -1, 1: 2}
+    const uint8_t payload[] = {0x84, 0x09, 0xA2, 'h', 'i', 0x00, 0x03, 0x07, 0xFF, 0x01, 0x02};
+    MusicStatus status;
+    TEST_ASSERT_TRUE(decode(payload, sizeof(payload), status));
+    TEST_ASSERT_EQUAL_UINT32(3, status.length);
+    TEST_ASSERT_EQUAL_UINT32(2, status.elapsed);
+}
+
+void test_msgpack_clamps_volume() {
+    // {0: 1, 1: 0, 4: 250}
+    const uint8_t payload[] = {0x83, 0x00, 0x01, 0x01, 0x00, 0x04, 0xCC, 0xFA};
+    MusicStatus status;
+    TEST_ASSERT_TRUE(decode(payload, sizeof(payload), status));
+    TEST_ASSERT_EQUAL_UINT8(100, status.volume);
+}
+
+void test_msgpack_rejects_bad_input() {
+    MusicStatus status;
+    // Missing elapsed
+    const uint8_t no_elapsed[] = {0x81, 0x00, 0x05};
+    TEST_ASSERT_FALSE(decode(no_elapsed, sizeof(no_elapsed), status));
+    // Cut off in the middle of a value
+    TEST_ASSERT_FALSE(decode(MSGPACK_FULL, 15, status));
+    // Unknown key holding a nested array
+    const uint8_t nested[] = {0x83, 0x00, 0x01, 0x01, 0x02, 0x09, 0x91, 0x01};
+    TEST_ASSERT_FALSE(decode(nested, sizeof(nested), status));
+    // Wrong type for a known key
+    const uint8_t bad_bool[] = {0x83, 0x00, 0x01, 0x01, 0x02, 0x02, 0x01};
+    TEST_ASSERT_FALSE(decode(bad_bool, sizeof(bad_bool), status));
+    TEST_ASSERT_FALSE(decode(MSGPACK_MINIMAL, 0, status));
+}
+
+// =========================================================================
+// JSON
+// =========================================================================
+
+void test_json_required_fields() {
+    MusicStatus status;
+    TEST_ASSERT_TRUE(decode(JSON_MINIMAL, status));
+    TEST_ASSERT_EQUAL_UINT32(204, status.length);
+    TEST_ASSERT_EQUAL_UINT32(107, status.elapsed);
+    TEST_ASSERT_EQUAL_UINT8(0, status.fields);
+}
+
+void test_json_matches_msgpack() {
+    MusicStatus from_json, from_msgpack;
+    TEST_ASSERT_TRUE(decode(JSON_FULL, from_json));
+    TEST_ASSERT_TRUE(decode(MSGPACK_FULL, sizeof(MSGPACK_FULL), from_msgpack));
+    TEST_ASSERT_EQUAL_UINT32(from_msgpack.length, from_json.length);
+    TEST_ASSERT_EQUAL_UINT32(from_msgpack.elapsed, from_json.elapsed);
+    TEST_ASSERT_EQUAL(from_msgpack.playing, from_json.playing);
+    TEST_ASSERT_EQUAL(from_msgpack.shuffle, from_json.shuffle);
+    TEST_ASSERT_EQUAL_UINT8(from_msgpack.volume, from_json.volume);
+    TEST_ASSERT_TRUE(from_msgpack.timestamp == from_json.timestamp);
+    TEST_ASSERT_EQUAL_UINT8(from_msgpack.fields, from_json.fields);
+}
+
+void test_json_rejects_bad_input() {
+    MusicStatus status;
+    TEST_ASSERT_FALSE(decode("{\"length\":204}", status));
+    TEST_ASSERT_FALSE(decode("{\"length\":204,\"elapsed\":", status));
+    TEST_ASSERT_FALSE(decode("not json", status));
+}
+
+// =========================================================================
+// TIMING
+// =========================================================================
+
+constexpr int BENCH_ITERATIONS = 50000;
+
+template <typename Decode>
+static double ns_per_decode(Decode decode_once) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) decode_once();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / BENCH_ITERATIONS;
+}
+
+/**
+ * @brief Decode cost of the same status in both encodings. Informational: the
+ *        numbers are for the host; the ratio is what carries over to the device.
+ */
+void test_decode_timing() {
+    MusicStatus status;
+    uint32_t sum = 0;
+    double msgpack_ns = ns_per_decode([&] {
+        decode(MSGPACK_FULL, sizeof(MSGPACK_FULL), status);
+        sum += status.elapsed;
+    });
+    double json_ns = ns_per_decode([&] {
+        decode(JSON_FULL, status);
+        sum += status.elapsed;
+    });
+
+    char report[128];
+    snprintf(report, sizeof(report), "MessagePack: %.0f ns (%u B), JSON: %.0f ns (%u B)",
+             msgpack_ns, (unsigned)sizeof(MSGPACK_FULL), json_ns, (unsigned)strlen(JSON_FULL));
+    TEST_MESSAGE(report);
+    TEST_ASSERT_EQUAL_UINT32(2 * BENCH_ITERATIONS * 107, sum);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_msgpack_required_fields);
+    RUN_TEST(test_msgpack_optional_fields);
+    RUN_TEST(test_msgpack_skips_unknown_keys);
+    RUN_TEST(test_msgpack_clamps_volume);
+    RUN_TEST(test_msgpack_rejects_bad_input);
+    RUN_TEST(test_json_required_fields);
+    RUN_TEST(test_json_matches_msgpack);
+    RUN_TEST(test_json_rejects_bad_input);
+    RUN_TEST(test_decode_timing);
+    return UNITY_END();
+}
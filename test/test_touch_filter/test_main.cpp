@@ -0,0 +1,185 @@
+// test/test_touch_filter/test_main.cpp
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "touch_filter.h"
+
+constexpr float SAMPLE_S = 0.01f; // FT6336 report rate in active mode
+constexpr uint32_t SAMPLE_US = 10000;
+
+// The same rest smoothing as TOUCH_PROFILE_DRAG with the speed adaptation off
+constexpr TouchFilterProfile FIXED_LOW_PASS = {1.0f, 0.0f, 1.0f, 0, 0};
+
+static uint32_t rng;
+
+void setUp(void) {
+    rng = 1;
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief Controller noise on a resting finger: -3..+3 px, uniform.
+ */
+static int noise_px() {
+    rng = rng * 1664525u + 1013904223u;
+    return (int)((rng >> 16) % 7) - 3;
+}
+
+/**
+ * @brief RMS distance from the true point of a resting finger, raw and filtered.
+ */
+static void rest_jitter(const TouchFilterProfile& profile, float& raw_rms, float& filtered_rms) {
+    OneEuroFilter filter;
+    filter.reset(160);
+    float raw_sum = 0, filtered_sum = 0;
+    int counted = 0;
+    for (int i = 0; i < 300; i++) {
+        int noise = noise_px();
+        float value = filter.filter(160 + noise, SAMPLE_S, profile);
+        if (i < 100) continue; // Settling
+        raw_sum += noise * noise;
+        filtered_sum += (value - 160) * (value - 160);
+        counted++;
+    }
+    raw_rms = sqrtf(raw_sum / counted);
+    filtered_rms = sqrtf(filtered_sum / counted);
+}
+
+/**
+ * @brief How far the filtered point trails a finger moving at constant speed, after 0.5 s.
+ */
+static float lag_px(const TouchFilterProfile& profile, float speed_px_s) {
+    OneEuroFilter filter;
+    filter.reset(0);
+    float value = 0;
+    for (int i = 1; i <= 50; i++) {
+        value = filter.filter(speed_px_s * i * SAMPLE_S, SAMPLE_S, profile);
+    }
+    return speed_px_s * 50 * SAMPLE_S - value;
+}
+
+// =========================================================================
+// JITTER
+// =========================================================================
+
+void test_resting_finger_jitters_less() {
+    float raw, filtered;
+    rest_jitter(TOUCH_PROFILE_DEFAULT, raw, filtered);
+    char message[80];
+    snprintf(message, sizeof(message), "default: rms %.2f px raw, %.2f px filtered", raw, filtered);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(raw * 0.6f, filtered);
+
+    rest_jitter(TOUCH_PROFILE_DRAG, raw, filtered);
+    snprintf(message, sizeof(message), "drag: rms %.2f px raw, %.2f px filtered", raw, filtered);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(raw * 0.5f, filtered);
+}
+
+void test_resting_finger_holds_its_pixel() {
+    // What a slider sees: the rounded point stays within a pixel or two
+    TouchFilter filter;
+    filter.set_profile(TOUCH_PROFILE_DRAG);
+    filter.begin(160, 120, 0);
+    int worst = 0;
+    for (uint32_t i = 1; i < 300; i++) {
+        filter.update(160 + noise_px(), 120 + noise_px(), i * SAMPLE_US);
+        int16_t x, y;
+        filter.filtered(x, y);
+        if (i > 100) {
+            worst = abs(x - 160) > worst ? abs(x - 160) : worst;
+            worst = abs(y - 120) > worst ? abs(y - 120) : worst;
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(2, worst);
+}
+
+// =========================================================================
+// LAG
+// =========================================================================
+
+void test_moving_finger_lags_little() {
+    const float speeds[] = {200, 500, 1000};
+    for (float speed : speeds) {
+        float default_lag = lag_px(TOUCH_PROFILE_DEFAULT, speed);
+        float drag_lag = lag_px(TOUCH_PROFILE_DRAG, speed);
+        float fixed_lag = lag_px(FIXED_LOW_PASS, speed);
+        char message[96];
+        snprintf(message, sizeof(message), "%4.0f px/s: lag %.1f px default, %.1f px drag, %.1f px fixed 1 Hz",
+                 speed, default_lag, drag_lag, fixed_lag);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_LESS_THAN(6.0f, default_lag);
+        TEST_ASSERT_LESS_THAN(4.0f, drag_lag);
+        // The speed adaptation is the point: a fixed filter as steady at rest trails far behind
+        TEST_ASSERT_LESS_THAN(fixed_lag / 10, drag_lag);
+    }
+}
+
+void test_prediction_leads_to_where_the_finger_will_be() {
+    const float speeds[] = {500, 1000};
+    for (float speed : speeds) {
+        TouchFilter filter;
+        filter.set_profile(TOUCH_PROFILE_DRAG);
+        filter.begin(0, 120, 0);
+        int16_t x = 0, y = 0;
+        for (uint32_t i = 1; i <= 50; i++) {
+            filter.update((int16_t)lroundf(speed * i * SAMPLE_S), 120, i * SAMPLE_US);
+        }
+        filter.predicted(x, y);
+        float ahead = speed * (50 * SAMPLE_S + TOUCH_PROFILE_DRAG.predict_us * 1e-6f);
+        TEST_ASSERT_FLOAT_WITHIN(5.0f, ahead, x);
+        TEST_ASSERT_EQUAL(120, y);
+    }
+}
+
+void test_prediction_is_capped_and_keeps_direction() {
+    TouchFilter filter;
+    filter.set_profile(TOUCH_PROFILE_DRAG);
+    filter.begin(0, 0, 0);
+    for (uint32_t i = 1; i <= 20; i++) {
+        filter.update(i * 30, i * 30, i * SAMPLE_US); // ~4200 px/s diagonally
+    }
+    int16_t fx, fy, px, py;
+    filter.filtered(fx, fy);
+    filter.predicted(px, py);
+    float step = sqrtf((float)(px - fx) * (px - fx) + (float)(py - fy) * (py - fy));
+    TEST_ASSERT_LESS_OR_EQUAL(TOUCH_PROFILE_DRAG.predict_max_px + 1, step);
+    TEST_ASSERT_INT_WITHIN(1, px - fx, py - fy);
+}
+
+void test_default_profile_does_not_predict() {
+    TouchFilter filter;
+    filter.begin(0, 0, 0);
+    for (uint32_t i = 1; i <= 20; i++) filter.update(i * 10, 0, i * SAMPLE_US);
+    int16_t fx, fy, px, py;
+    filter.filtered(fx, fy);
+    filter.predicted(px, py);
+    TEST_ASSERT_EQUAL(fx, px);
+    TEST_ASSERT_EQUAL(fy, py);
+}
+
+void test_long_gap_starts_over() {
+    TouchFilter filter;
+    filter.set_profile(TOUCH_PROFILE_DRAG);
+    filter.begin(0, 0, 0);
+    for (uint32_t i = 1; i <= 10; i++) filter.update(0, 0, i * SAMPLE_US);
+    filter.update(200, 200, 10 * SAMPLE_US + 200000); // Lifted and touched elsewhere
+    int16_t x, y;
+    filter.predicted(x, y);
+    TEST_ASSERT_EQUAL(200, x);
+    TEST_ASSERT_EQUAL(200, y);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_resting_finger_jitters_less);
+    RUN_TEST(test_resting_finger_holds_its_pixel);
+    RUN_TEST(test_moving_finger_lags_little);
+    RUN_TEST(test_prediction_leads_to_where_the_finger_will_be);
+    RUN_TEST(test_prediction_is_capped_and_keeps_direction);
+    RUN_TEST(test_default_profile_does_not_predict);
+    RUN_TEST(test_long_gap_starts_over);
+    return UNITY_END();
+}